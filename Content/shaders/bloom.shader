@@ -6,11 +6,14 @@ layout(location = 1) in vec2 a_TexCoords;
 
 layout(location = 0) out vec2 TexCoords;
 
+// Image portion of the output (xy) and of the hdr input (zw)
+uniform vec4 u_Region = vec4(1.0, 1.0, 1.0, 1.0);
+
 void main()
 {
 	TexCoords = a_TexCoords;
 
-	gl_Position = vec4(a_Position.x, a_Position.y, 0.0f, 1.0f);
+	gl_Position = vec4((a_Position + 1.0) * u_Region.xy - 1.0, 0.0f, 1.0f);
 }
 
 #shader fragment
@@ -20,13 +23,18 @@ layout(location = 0) in vec2 TexCoords;
 
 layout(location = 0) out vec4 Color;
 
+uniform vec4 u_Region = vec4(1.0, 1.0, 1.0, 1.0);
+
 layout(binding = 0) uniform sampler2D albedoTexture;
 layout(binding = 1) uniform sampler2D bloomTexture;
 
+// Portion of the bloom texture holding the blur, which can differ from the hdr target's
+uniform vec2 u_BloomScale = vec2(1.0, 1.0);
+
 void main()
 {
-	vec3 hdrColor = texture(albedoTexture, TexCoords).rgb;
-	vec3 bloomColor = texture(bloomTexture, TexCoords).rgb;
+	vec3 hdrColor = texture(albedoTexture, TexCoords * u_Region.zw).rgb;
+	vec3 bloomColor = texture(bloomTexture, TexCoords * u_BloomScale).rgb;
 	
 	hdrColor += bloomColor; // additive blending
 	
@@ -0,0 +1,46 @@
+#shader vertex
+#version 420
+
+layout(location = 0) in vec2 a_Position;
+layout(location = 1) in vec2 a_TexCoords;
+
+layout(location = 0) out vec2 TexCoords;
+
+// Full level drawn (xy), image portion of the bright pass read by the first level (zw)
+uniform vec4 u_Region = vec4(1.0, 1.0, 1.0, 1.0);
+
+void main()
+{
+	TexCoords = a_TexCoords;
+
+	gl_Position = vec4((a_Position + 1.0) * u_Region.xy - 1.0, 0.0f, 1.0f);
+}
+
+#shader fragment
+#version 420
+			
+layout(location = 0) in vec2 TexCoords;
+
+layout(location = 0) out vec4 Color;
+
+uniform vec4 u_Region = vec4(1.0, 1.0, 1.0, 1.0);
+
+layout(binding = 0) uniform sampler2D sampleTexture;
+
+// Dual filter downsample - each diagonal tap lands between texels to average a 2x2 block
+void main()
+{
+	vec2 tex_offset = 1.0 / textureSize(sampleTexture, 0); // gets size of single texel
+
+	// Taps stay within the part of the source holding the image
+	vec2 uv = TexCoords * u_Region.zw;
+	vec2 maxUV = u_Region.zw - tex_offset * 0.5;
+
+	vec3 result = texture(sampleTexture, uv).rgb * 4.0;
+	result += texture(sampleTexture, min(uv + vec2(-tex_offset.x, -tex_offset.y), maxUV)).rgb;
+	result += texture(sampleTexture, min(uv + vec2( tex_offset.x, -tex_offset.y), maxUV)).rgb;
+	result += texture(sampleTexture, min(uv + vec2(-tex_offset.x,  tex_offset.y), maxUV)).rgb;
+	result += texture(sampleTexture, min(uv + vec2( tex_offset.x,  tex_offset.y), maxUV)).rgb;
+
+	Color = vec4(result / 8.0, 1.0);
+}
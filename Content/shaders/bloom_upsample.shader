@@ -0,0 +1,45 @@
+#shader vertex
+#version 420
+
+layout(location = 0) in vec2 a_Position;
+layout(location = 1) in vec2 a_TexCoords;
+
+layout(location = 0) out vec2 TexCoords;
+
+void main()
+{
+	TexCoords = a_TexCoords;
+
+	gl_Position = vec4(a_Position.x, a_Position.y, 0.0f, 1.0f);
+}
+
+#shader fragment
+#version 420
+			
+layout(location = 0) in vec2 TexCoords;
+
+layout(location = 0) out vec4 Color;
+
+layout(binding = 0) uniform sampler2D coarseTexture;
+layout(binding = 1) uniform sampler2D levelTexture;
+
+// Dual filter upsample - tent filter the coarser level and blend it with the current level
+void main()
+{
+	vec2 tex_offset = 1.0 / textureSize(coarseTexture, 0); // gets size of single texel
+
+	vec3 upsampled = texture(coarseTexture, TexCoords + vec2(-tex_offset.x * 2.0, 0.0)).rgb;
+	upsampled += texture(coarseTexture, TexCoords + vec2(-tex_offset.x, tex_offset.y)).rgb * 2.0;
+	upsampled += texture(coarseTexture, TexCoords + vec2(0.0, tex_offset.y * 2.0)).rgb;
+	upsampled += texture(coarseTexture, TexCoords + vec2(tex_offset.x, tex_offset.y)).rgb * 2.0;
+	upsampled += texture(coarseTexture, TexCoords + vec2(tex_offset.x * 2.0, 0.0)).rgb;
+	upsampled += texture(coarseTexture, TexCoords + vec2(tex_offset.x, -tex_offset.y)).rgb * 2.0;
+	upsampled += texture(coarseTexture, TexCoords + vec2(0.0, -tex_offset.y * 2.0)).rgb;
+	upsampled += texture(coarseTexture, TexCoords + vec2(-tex_offset.x, -tex_offset.y)).rgb * 2.0;
+	upsampled /= 12.0;
+
+	vec3 level = texture(levelTexture, TexCoords).rgb;
+
+	// Halving at each level keeps the combined weights of the whole chain summing to one
+	Color = vec4(mix(level, upsampled, 0.5), 1.0);
+}
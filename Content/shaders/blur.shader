@@ -6,11 +6,14 @@ layout(location = 1) in vec2 a_TexCoords;
 
 layout(location = 0) out vec2 TexCoords;
 
+// Image portion of the ping-pong targets, drawn (xy) and read (zw)
+uniform vec4 u_Region = vec4(1.0, 1.0, 1.0, 1.0);
+
 void main()
 {
 	TexCoords = a_TexCoords;
 
-	gl_Position = vec4(a_Position.x, a_Position.y, 0.0f, 1.0f);
+	gl_Position = vec4((a_Position + 1.0) * u_Region.xy - 1.0, 0.0f, 1.0f);
 }
 
 #shader fragment
@@ -20,6 +23,8 @@ layout(location = 0) in vec2 TexCoords;
 
 layout(location = 0) out vec4 Color;
 
+uniform vec4 u_Region = vec4(1.0, 1.0, 1.0, 1.0);
+
 layout(binding = 0) uniform sampler2D sampleTexture;
 
 uniform bool horizontal;
@@ -28,21 +33,26 @@ uniform float weight[5] = float[] (0.2270270270, 0.1945945946, 0.1216216216, 0.0
 void main()
 {
 	vec2 tex_offset = 1.0 / textureSize(sampleTexture, 0); // gets size of single texel
-    vec3 result = texture(sampleTexture, TexCoords).rgb * weight[0];
+
+	// Taps stay within the part of the source holding the image
+	vec2 uv = TexCoords * u_Region.zw;
+	vec2 maxUV = u_Region.zw - tex_offset * 0.5;
+
+    vec3 result = texture(sampleTexture, uv).rgb * weight[0];
     if(horizontal)
     {
         for(int i = 1; i < 5; ++i)
         {
-           result += texture(sampleTexture, TexCoords + vec2(tex_offset.x * i, 0.0)).rgb * weight[i];
-           result += texture(sampleTexture, TexCoords - vec2(tex_offset.x * i, 0.0)).rgb * weight[i];
+           result += texture(sampleTexture, min(uv + vec2(tex_offset.x * i, 0.0), maxUV)).rgb * weight[i];
+           result += texture(sampleTexture, min(uv - vec2(tex_offset.x * i, 0.0), maxUV)).rgb * weight[i];
         }
     }
     else
     {
         for(int i = 1; i < 5; ++i)
         {
-            result += texture(sampleTexture, TexCoords + vec2(0.0, tex_offset.y * i)).rgb * weight[i];
-            result += texture(sampleTexture, TexCoords - vec2(0.0, tex_offset.y * i)).rgb * weight[i];
+            result += texture(sampleTexture, min(uv + vec2(0.0, tex_offset.y * i), maxUV)).rgb * weight[i];
+            result += texture(sampleTexture, min(uv - vec2(0.0, tex_offset.y * i), maxUV)).rgb * weight[i];
         }
     }
 	Color = vec4(result, 1.0);
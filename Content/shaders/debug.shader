@@ -6,11 +6,14 @@ layout(location = 1) in vec2 a_TexCoords;
 
 layout(location = 0) out vec2 TexCoords;
 
+// Image portion of the output (xy) and of the texture shown (zw)
+uniform vec4 u_Region = vec4(1.0, 1.0, 1.0, 1.0);
+
 void main()
 {
 	TexCoords = a_TexCoords;
 
-	gl_Position = vec4(a_Position.x, a_Position.y, 0.0f, 1.0f);
+	gl_Position = vec4((a_Position + 1.0) * u_Region.xy - 1.0, 0.0f, 1.0f);
 }
 
 #shader fragment
@@ -20,11 +23,13 @@ layout(location = 0) in vec2 TexCoords;
 
 layout(location = 0) out vec4 Color;
 
+uniform vec4 u_Region = vec4(1.0, 1.0, 1.0, 1.0);
+
 layout(binding = 0) uniform sampler2D sampleTexture;
 
 void main()
 {
-	vec3 sampleColor = texture(sampleTexture, TexCoords).rgb;
+	vec3 sampleColor = texture(sampleTexture, TexCoords * u_Region.zw).rgb;
 
 	// tone mapping
 	vec3 result = vec3(1.0) - exp(-sampleColor * u_Exposure);
@@ -7,12 +7,17 @@ layout(location = 1) in vec2 a_TexCoords;
 layout(location = 0) out vec2 TexCoords;
 layout(location = 1) out vec2 PixCoord;
 
+// Sub region of the full output being drawn (xy - offset, zw - scale), used by tiled exports
+uniform vec4 u_TileRegion = vec4(0.0, 0.0, 1.0, 1.0);
+// Image portion of the pixel target
+uniform vec2 u_TargetScale = vec2(1.0, 1.0);
+
 void main()
 {
-	TexCoords = a_TexCoords;
-	PixCoord = a_TexCoords * u_Viewport.xy;
+	TexCoords = u_TileRegion.xy + a_TexCoords * u_TileRegion.zw;
+	PixCoord = TexCoords * u_Viewport.xy;
 
-	gl_Position = vec4(a_Position.x, a_Position.y, 0.0f, 1.0f);
+	gl_Position = vec4((a_Position + 1.0) * u_TargetScale - 1.0, 0.0f, 1.0f);
 }
 
 #shader fragment
@@ -22,9 +27,15 @@ layout(location = 0) in vec2 TexCoords;
 layout(location = 1) in vec2 PixCoord;
 
 layout(location = 0) out vec4 Color;
+#ifdef BLOOM_OUTPUT
 layout(location = 1) out vec4 BloomColor;
+#endif
+
+layout (binding = 8) uniform sampler2D textureMaps[8];
+layout (binding = 16) uniform sampler2D bufferMaps[4];
 
-layout (binding = 0) uniform sampler2D textureMaps[8];
+uniform float u_PlaybackTime;
+uniform int u_Frame;
 
 #define UVS TexCoords
 #define PIXCOORD PixCoord
@@ -34,7 +45,8 @@ layout (binding = 0) uniform sampler2D textureMaps[8];
 #define GAMMA u_GammaAdjustment.x
 #define EXPOSURE u_Exposure
 
-#define TIME u_Time
+#define TIME u_PlaybackTime
+#define FRAME u_Frame
 
 #define TEX0 textureMaps[0]
 #define TEX1 textureMaps[1]
@@ -44,15 +56,22 @@ layout (binding = 0) uniform sampler2D textureMaps[8];
 #define TEX5 textureMaps[5]
 #define TEX6 textureMaps[6]
 
+#define BUFFER_A bufferMaps[0]
+#define BUFFER_B bufferMaps[1]
+#define BUFFER_C bufferMaps[2]
+#define BUFFER_D bufferMaps[3]
+
 void PixelProcess(out vec4 color);
 
 void main()
 {
 	PixelProcess(Color);
 
+#ifdef BLOOM_OUTPUT
 	float brightness = dot(Color.rgb, vec3(0.2126, 0.7152, 0.0722));
     if(brightness > 1.0)
         BloomColor = vec4(Color.rgb, 1.0);
     else
         BloomColor = vec4(0.0, 0.0, 0.0, 1.0);
+#endif
 }
@@ -32,6 +32,8 @@ project "SVisualizer"
 		"%{ImGui_IncludeDir.ImNodes}",
 		"%{ImGui_IncludeDir.ImTextEditor}",
 		
+		"%{IncludeDir.glad}",
+		"%{IncludeDir.glfw}",
 		"%{IncludeDir.entt}",
 		"%{IncludeDir.IconFontCppHeaders}",
 		"%{IncludeDir.stduuid}",
@@ -0,0 +1,182 @@
+#include "svis_pch.h"
+#include "BackgroundShaderCompiler.h"
+
+#include "Elysium.h"
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+BackgroundShaderCompiler::BackgroundShaderCompiler(const ShaderPackageCompiler& compiler)
+	: m_compiler(compiler),
+	m_context(nullptr),
+	m_latestRequestId(0),
+	m_pendingRequestId(0),
+	m_pendingValidateFirst(false),
+	m_compiling(false),
+	m_hasResult(false),
+	m_stopping(false)
+{
+	// Hidden 1x1 window whose context shares programs with the application's
+	GLFWwindow* mainContext = glfwGetCurrentContext();
+	if (mainContext != nullptr)
+	{
+		glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+		m_context = glfwCreateWindow(1, 1, "Shader Compiler", nullptr, mainContext);
+		glfwWindowHint(GLFW_VISIBLE, GLFW_TRUE);
+	}
+
+	if (m_context != nullptr)
+		m_worker = std::thread(&BackgroundShaderCompiler::WorkerLoop, this);
+	else
+		ELYSIUM_WARN("Failed to Create Shared Compile Context, Compiling on the Render Thread.");
+}
+
+BackgroundShaderCompiler::~BackgroundShaderCompiler()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stopping = true;
+	}
+	m_condition.notify_all();
+
+	if (m_worker.joinable())
+		m_worker.join();
+
+	if (m_context != nullptr)
+		glfwDestroyWindow(m_context);
+}
+
+uint64_t BackgroundShaderCompiler::Request(const std::string& code, const BufferPassCodes& bufferCode, bool validateFirst)
+{
+	uint64_t requestId = 0;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		requestId = ++m_latestRequestId;
+
+		// Replaces whatever was still waiting
+		m_pendingRequestId = requestId;
+		m_pendingCode = code;
+		m_pendingBufferCode = bufferCode;
+		m_pendingValidateFirst = validateFirst;
+	}
+
+	if (!IsAsync())
+	{
+		Result result = CompileCode(requestId, code, bufferCode, validateFirst);
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_pendingRequestId = 0;
+		m_result = std::move(result);
+		m_hasResult = true;
+		return requestId;
+	}
+
+	m_condition.notify_one();
+	return requestId;
+}
+
+bool BackgroundShaderCompiler::TryGetResult(Result& result)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if (!m_hasResult)
+		return false;
+
+	result = std::move(m_result);
+	m_result = Result();
+	m_hasResult = false;
+	return true;
+}
+
+bool BackgroundShaderCompiler::IsCompiling() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_compiling || m_pendingRequestId != 0;
+}
+
+void BackgroundShaderCompiler::WorkerLoop()
+{
+	glfwMakeContextCurrent(m_context);
+
+	while (true)
+	{
+		uint64_t requestId = 0;
+		std::string code;
+		BufferPassCodes bufferCode;
+		bool validateFirst = false;
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_condition.wait(lock, [this]() { return m_stopping || m_pendingRequestId != 0; });
+			if (m_stopping)
+				break;
+
+			requestId = m_pendingRequestId;
+			code = std::move(m_pendingCode);
+			bufferCode = std::move(m_pendingBufferCode);
+			validateFirst = m_pendingValidateFirst;
+			m_pendingRequestId = 0;
+			m_compiling = true;
+		}
+
+		Result result = CompileCode(requestId, code, bufferCode, validateFirst);
+
+		// Programs have to be complete before the render thread's context can use them
+		glFinish();
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_compiling = false;
+
+		// A newer request was queued while compiling, this one is stale
+		if (requestId != m_latestRequestId)
+			continue;
+
+		m_result = std::move(result);
+		m_hasResult = true;
+	}
+
+	glfwMakeContextCurrent(nullptr);
+}
+
+BackgroundShaderCompiler::Result BackgroundShaderCompiler::CompileCode(uint64_t requestId, const std::string& code, const BufferPassCodes& bufferCode, bool validateFirst) const
+{
+	Result result;
+	result.RequestId = requestId;
+	result.Code = code;
+	result.BufferCode = bufferCode;
+
+	const auto compilePrograms = [&]()
+	{
+		result.Success = m_compiler.CompileVariants(code, result.Shaders, &result.Error) &&
+						 m_compiler.CompileBuffers(bufferCode, result.BufferShaders, &result.Error);
+		return result.Success;
+	};
+
+	// Cached programs link without the driver compiler ever seeing the code
+	if (!validateFirst && compilePrograms())
+		return result;
+
+	// Every pass is validated so errors in all of them show up at once
+	bool valid = m_compiler.Validate(code, result.Messages);
+	for (uint8_t pass = 0; pass < ShaderPackage::MaxBufferPasses; ++pass)
+	{
+		if (!bufferCode[pass].empty())
+			valid = m_compiler.Validate(bufferCode[pass], result.Messages, pass) && valid;
+	}
+
+	if (!valid)
+	{
+		result.Success = false;
+		result.Error.clear();
+		for (const ShaderCompileMessage& message : result.Messages)
+		{
+			if (message.Pass < ShaderPackage::MaxBufferPasses)
+				result.Error += std::string(PassGraph::GetBufferName(message.Pass)) + ": ";
+			result.Error += message.Text + "\n";
+		}
+		return result;
+	}
+
+	// Without validateFirst the programs already failed to link, that error stands
+	if (validateFirst)
+		compilePrograms();
+	return result;
+}
\ No newline at end of file
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "ShaderPackage.h"
+#include "ShaderPackageCompiler.h"
+
+struct GLFWwindow;
+
+// Compiles package code on a worker thread owning a hidden context that shares objects
+// with the main one, so driver compile and link never stall the frame. Only the newest
+// request matters, anything queued behind it is dropped and stale results are discarded.
+// Live edits are validated first so only code that compiles is linked into the program variants,
+// other requests link straight away and let the program binary cache skip the driver compiler.
+// The image code and the buffer pass codes travel together, a result always covers all of them.
+class BackgroundShaderCompiler
+{
+public:
+	struct Result
+	{
+		uint64_t RequestId = 0;
+		bool Success = false;
+		std::string Code;
+		BufferPassCodes BufferCode;
+		std::string Error;
+		std::vector<ShaderCompileMessage> Messages;
+		ShaderVariants Shaders;
+		BufferPassShaders BufferShaders;
+	};
+public:
+	BackgroundShaderCompiler(const ShaderPackageCompiler& compiler);
+	~BackgroundShaderCompiler();
+public:
+	// Supersedes any request that hasn't started compiling yet. Without validateFirst the code
+	// is only validated to report why linking failed.
+	uint64_t Request(const std::string& code, const BufferPassCodes& bufferCode, bool validateFirst);
+
+	// Retrieves the result of the newest request once it has finished
+	bool TryGetResult(Result& result);
+
+	bool IsCompiling() const;
+	inline bool IsAsync() const { return m_context != nullptr; }
+private:
+	void WorkerLoop();
+	Result CompileCode(uint64_t requestId, const std::string& code, const BufferPassCodes& bufferCode, bool validateFirst) const;
+private:
+	const ShaderPackageCompiler& m_compiler;
+
+	GLFWwindow* m_context;
+	std::thread m_worker;
+
+	mutable std::mutex m_mutex;
+	std::condition_variable m_condition;
+
+	uint64_t m_latestRequestId;
+	uint64_t m_pendingRequestId;
+	std::string m_pendingCode;
+	BufferPassCodes m_pendingBufferCode;
+	bool m_pendingValidateFirst;
+	bool m_compiling;
+	bool m_hasResult;
+	Result m_result;
+	bool m_stopping;
+};
\ No newline at end of file
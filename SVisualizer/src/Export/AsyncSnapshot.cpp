@@ -0,0 +1,162 @@
+#include "svis_pch.h"
+#include "AsyncSnapshot.h"
+
+#include "Export/ExrWriter.h"
+
+#include <opencv2/opencv.hpp>
+
+static void FlipAndSwizzleInPlace(uint8_t* pixels, uint32_t width, uint32_t height)
+{
+	// Gl rows start at the bottom of the image and opencv expects bgra ordering
+	const size_t rowSize = static_cast<size_t>(width) * 4;
+	for (uint32_t y = 0; y < (height + 1) / 2; ++y)
+	{
+		uint8_t* top = pixels + rowSize * y;
+		uint8_t* bottom = pixels + rowSize * (height - 1 - y);
+		for (size_t x = 0; x < rowSize; x += 4)
+		{
+			if (top != bottom)
+			{
+				std::swap(top[x + 0], bottom[x + 2]);
+				std::swap(top[x + 1], bottom[x + 1]);
+				std::swap(top[x + 2], bottom[x + 0]);
+				std::swap(top[x + 3], bottom[x + 3]);
+			}
+			else
+			{
+				std::swap(top[x + 0], top[x + 2]);
+			}
+		}
+	}
+}
+
+AsyncSnapshot::AsyncSnapshot()
+	: m_state(State::Idle),
+	m_encodeDone(false),
+	m_encodeSucceeded(false),
+	m_succeeded(false),
+	m_finishedTime(-1.0f)
+{
+	m_encoder.Start(1, 1);
+}
+
+AsyncSnapshot::~AsyncSnapshot()
+{
+	// The mapped buffer has to outlive the encoder
+	m_encoder.Stop();
+	m_readback.Release();
+}
+
+bool AsyncSnapshot::Begin(const Elysium::Shared<Elysium::FrameBuffer>& framebuffer, uint32_t width, uint32_t height, const std::string& filepath)
+{
+	if (IsBusy() || filepath.empty())
+		return false;
+
+	if (!m_readback.Queue(framebuffer, width, height, 0))
+		return false;
+
+	m_images.push_back({ filepath, width, height, false });
+
+	m_filepath = filepath;
+	m_succeeded = true;
+	m_state = State::Reading;
+	return true;
+}
+
+bool AsyncSnapshot::BeginHdr(const std::vector<HdrLayer>& layers)
+{
+	if (IsBusy() || layers.empty() || layers.size() > PixelReadback::RingSize)
+		return false;
+
+	for (const HdrLayer& layer : layers)
+	{
+		if (!m_readback.QueueTexture(layer.Texture, static_cast<uint32_t>(m_images.size()), PixelReadback::PixelType::HalfFloat))
+			break;
+
+		m_images.push_back({ layer.Filepath, layer.Texture->GetWidth(), layer.Texture->GetHeight(), true });
+	}
+
+	if (m_images.empty())
+		return false;
+
+	m_filepath = layers.front().Filepath;
+	m_succeeded = m_images.size() == layers.size();
+	m_state = State::Reading;
+	return true;
+}
+
+void AsyncSnapshot::Update()
+{
+	if (m_state == State::Reading)
+	{
+		uint32_t tag = 0;
+		uint32_t size = 0;
+		uint8_t* pixels = m_readback.TryMapOldest(tag, size, true);
+		if (pixels)
+		{
+			EncodeImage(pixels);
+			m_state = State::Encoding;
+		}
+		else if (m_readback.IsEmpty())
+		{
+			// A failed map frees the slot, otherwise the copy is still in flight
+			ELYSIUM_WARN("Failed to Read Back Snapshot Pixels");
+			m_images.clear();
+			m_succeeded = false;
+			m_finishedTime = Elysium::Time::TotalTime();
+			m_state = State::Idle;
+		}
+	}
+	else if (m_state == State::Encoding && m_encodeDone)
+	{
+		FinishImage();
+	}
+}
+
+void AsyncSnapshot::EncodeImage(uint8_t* pixels)
+{
+	m_encodeDone = false;
+	m_encodeSucceeded = false;
+
+	const PendingImage image = m_images.front();
+	m_encoder.TryPush([this, pixels, image]()
+	{
+		// Both paths read the mapped memory directly
+		if (image.HalfFloat)
+		{
+			m_encodeSucceeded = ExrWriter::WriteHalfRGBA(image.Filepath, reinterpret_cast<const uint16_t*>(pixels), image.Width, image.Height);
+		}
+		else
+		{
+			FlipAndSwizzleInPlace(pixels, image.Width, image.Height);
+
+			const cv::Mat wrapped(image.Height, image.Width, CV_8UC4, pixels);
+			m_encodeSucceeded = cv::imwrite(image.Filepath, wrapped);
+		}
+		m_encodeDone = true;
+	});
+}
+
+void AsyncSnapshot::FinishImage()
+{
+	m_readback.UnmapOldest();
+
+	const std::string& filepath = m_images.front().Filepath;
+	if (m_encodeSucceeded)
+		ELYSIUM_INFO("Wrote Snapshot to {0}", filepath);
+	else
+		ELYSIUM_WARN("Failed to Write Snapshot to {0}", filepath);
+
+	m_succeeded = m_succeeded && m_encodeSucceeded;
+	m_images.pop_front();
+
+	if (m_images.empty())
+	{
+		m_finishedTime = Elysium::Time::TotalTime();
+		m_state = State::Idle;
+	}
+	else
+	{
+		m_state = State::Reading;
+	}
+}
\ No newline at end of file
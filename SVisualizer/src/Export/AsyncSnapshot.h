@@ -0,0 +1,72 @@
+#pragma once
+
+#include "Elysium.h"
+
+#include "Export/PixelReadback.h"
+#include "Export/EncodeQueue.h"
+
+#include <atomic>
+
+// Saves a framebuffer to disk without blocking the frame. The pixels are read back
+// through a fenced pack buffer and encoded straight out of the mapped memory on
+// a worker thread, swizzling and flipping them in place. Half float targets are
+// written as OpenEXR at their native precision.
+class AsyncSnapshot
+{
+public:
+	enum class State : uint8_t
+	{
+		Idle,
+		Reading,
+		Encoding
+	};
+
+	struct HdrLayer
+	{
+		Elysium::Shared<Elysium::Texture2D> Texture;
+		std::string Filepath;
+	};
+public:
+	AsyncSnapshot();
+	~AsyncSnapshot();
+public:
+	bool Begin(const Elysium::Shared<Elysium::FrameBuffer>& framebuffer, uint32_t width, uint32_t height, const std::string& filepath);
+
+	// Writes each rgba16f texture to its own exr, at most one per readback slot
+	bool BeginHdr(const std::vector<HdrLayer>& layers);
+
+	// Polls the readback and encoder, needs to be called every frame from the render thread
+	void Update();
+
+	inline bool IsBusy() const { return m_state != State::Idle; }
+	inline State GetState() const { return m_state; }
+
+	inline const std::string& GetFilepath() const { return m_filepath; }
+	inline bool LastSucceeded() const { return m_succeeded; }
+
+	// Time the last snapshot finished, used to fade out the completion status
+	inline float GetFinishedTime() const { return m_finishedTime; }
+private:
+	void EncodeImage(uint8_t* pixels);
+	void FinishImage();
+private:
+	struct PendingImage
+	{
+		std::string Filepath;
+		uint32_t Width;
+		uint32_t Height;
+		bool HalfFloat;
+	};
+
+	PixelReadback m_readback;
+	EncodeQueue m_encoder;
+
+	State m_state;
+	std::string m_filepath;
+	std::deque<PendingImage> m_images;
+
+	std::atomic<bool> m_encodeDone;
+	std::atomic<bool> m_encodeSucceeded;
+	bool m_succeeded;
+	float m_finishedTime;
+};
\ No newline at end of file
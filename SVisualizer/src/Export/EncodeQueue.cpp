@@ -0,0 +1,94 @@
+#include "svis_pch.h"
+#include "EncodeQueue.h"
+
+EncodeQueue::EncodeQueue()
+	: m_capacity(0),
+	m_activeJobs(0),
+	m_stopping(false)
+{
+}
+
+EncodeQueue::~EncodeQueue()
+{
+	Stop();
+}
+
+void EncodeQueue::Start(uint32_t workerCount, uint32_t capacity)
+{
+	Stop();
+
+	m_capacity = std::max(capacity, 1u);
+	m_stopping = false;
+
+	for (uint32_t i = 0; i < std::max(workerCount, 1u); ++i)
+		m_workers.emplace_back(&EncodeQueue::WorkerLoop, this);
+}
+
+void EncodeQueue::Stop()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stopping = true;
+	}
+	m_condition.notify_all();
+
+	for (std::thread& worker : m_workers)
+		worker.join();
+	m_workers.clear();
+}
+
+bool EncodeQueue::TryPush(Job&& job)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (m_workers.empty() || m_jobs.size() >= m_capacity)
+			return false;
+
+		m_jobs.push_back(std::move(job));
+	}
+	m_condition.notify_one();
+	return true;
+}
+
+void EncodeQueue::Clear()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_jobs.clear();
+}
+
+bool EncodeQueue::IsIdle() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_jobs.empty() && m_activeJobs == 0;
+}
+
+size_t EncodeQueue::GetQueuedCount() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_jobs.size();
+}
+
+void EncodeQueue::WorkerLoop()
+{
+	while (true)
+	{
+		Job job;
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_condition.wait(lock, [this]() { return m_stopping || !m_jobs.empty(); });
+
+			// Remaining jobs are still drained when stopping
+			if (m_jobs.empty())
+				return;
+
+			job = std::move(m_jobs.front());
+			m_jobs.pop_front();
+			++m_activeJobs;
+		}
+
+		job();
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+		--m_activeJobs;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,41 @@
+#pragma once
+
+// Bounded job queue drained by worker threads. Pushing never blocks, a full
+// queue is reported back so the producer can hold off instead of stalling.
+class EncodeQueue
+{
+public:
+	using Job = std::function<void()>;
+public:
+	EncodeQueue();
+	~EncodeQueue();
+public:
+	void Start(uint32_t workerCount, uint32_t capacity);
+
+	// Finishes every queued job before joining the workers
+	void Stop();
+
+	bool TryPush(Job&& job);
+
+	// Drops every job that hasn't started yet
+	void Clear();
+
+	// Whether no job is queued or running
+	bool IsIdle() const;
+	size_t GetQueuedCount() const;
+
+	inline bool IsRunning() const { return !m_workers.empty(); }
+	inline uint32_t GetCapacity() const { return m_capacity; }
+private:
+	void WorkerLoop();
+private:
+	std::vector<std::thread> m_workers;
+	std::deque<Job> m_jobs;
+
+	mutable std::mutex m_mutex;
+	std::condition_variable m_condition;
+
+	uint32_t m_capacity;
+	uint32_t m_activeJobs;
+	bool m_stopping;
+};
\ No newline at end of file
@@ -0,0 +1,111 @@
+#include "svis_pch.h"
+#include "ExrWriter.h"
+
+#include <cstring>
+
+static constexpr uint32_t ExrMagic = 20000630;
+static constexpr uint32_t ExrVersion = 2;
+static constexpr int32_t ExrPixelTypeHalf = 1;
+
+// Channels are stored in alphabetical order, each one mapped to its rgba component
+static constexpr std::array<std::pair<const char*, uint8_t>, 4> ExrChannels = {{ { "A", 3 }, { "B", 2 }, { "G", 1 }, { "R", 0 } }};
+
+template<typename T>
+static void Write(std::ofstream& stream, T value)
+{
+	// Exr is little endian, as are the targeted platforms
+	stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+static void WriteAttributeHeader(std::ofstream& stream, const char* name, const char* type, int32_t size)
+{
+	stream.write(name, std::strlen(name) + 1);
+	stream.write(type, std::strlen(type) + 1);
+	Write<int32_t>(stream, size);
+}
+
+static void WriteBox(std::ofstream& stream, const char* name, uint32_t width, uint32_t height)
+{
+	WriteAttributeHeader(stream, name, "box2i", 16);
+	Write<int32_t>(stream, 0);
+	Write<int32_t>(stream, 0);
+	Write<int32_t>(stream, static_cast<int32_t>(width) - 1);
+	Write<int32_t>(stream, static_cast<int32_t>(height) - 1);
+}
+
+bool ExrWriter::WriteHalfRGBA(const std::string& filepath, const uint16_t* pixels, uint32_t width, uint32_t height)
+{
+	if (!pixels || width == 0 || height == 0)
+		return false;
+
+	std::ofstream stream(filepath, std::ios::binary | std::ios::trunc);
+	if (!stream.is_open())
+		return false;
+
+	Write<uint32_t>(stream, ExrMagic);
+	Write<uint32_t>(stream, ExrVersion);
+
+	// Header
+	int32_t channelListSize = 1;
+	for (const auto& channel : ExrChannels)
+		channelListSize += static_cast<int32_t>(std::strlen(channel.first)) + 1 + 16;
+
+	WriteAttributeHeader(stream, "channels", "chlist", channelListSize);
+	for (const auto& channel : ExrChannels)
+	{
+		stream.write(channel.first, std::strlen(channel.first) + 1);
+		Write<int32_t>(stream, ExrPixelTypeHalf);
+		Write<uint32_t>(stream, 0);		// pLinear + reserved
+		Write<int32_t>(stream, 1);		// xSampling
+		Write<int32_t>(stream, 1);		// ySampling
+	}
+	stream.put(0);
+
+	WriteAttributeHeader(stream, "compression", "compression", 1);
+	stream.put(0);
+
+	WriteBox(stream, "dataWindow", width, height);
+	WriteBox(stream, "displayWindow", width, height);
+
+	WriteAttributeHeader(stream, "lineOrder", "lineOrder", 1);
+	stream.put(0);
+
+	WriteAttributeHeader(stream, "pixelAspectRatio", "float", 4);
+	Write<float>(stream, 1.0f);
+
+	WriteAttributeHeader(stream, "screenWindowCenter", "v2f", 8);
+	Write<float>(stream, 0.0f);
+	Write<float>(stream, 0.0f);
+
+	WriteAttributeHeader(stream, "screenWindowWidth", "float", 4);
+	Write<float>(stream, 1.0f);
+
+	stream.put(0);
+
+	// Offset table - uncompressed files store a single scanline per block
+	const uint32_t lineSize = width * static_cast<uint32_t>(ExrChannels.size()) * sizeof(uint16_t);
+	const uint64_t blockSize = sizeof(int32_t) * 2 + lineSize;
+	const uint64_t firstBlock = static_cast<uint64_t>(stream.tellp()) + sizeof(uint64_t) * height;
+	for (uint32_t y = 0; y < height; ++y)
+		Write<uint64_t>(stream, firstBlock + blockSize * y);
+
+	// Scanlines - exr rows run top down, so gl rows are walked in reverse
+	std::vector<uint16_t> line(width * ExrChannels.size());
+	for (uint32_t y = 0; y < height; ++y)
+	{
+		const uint16_t* row = pixels + static_cast<size_t>(height - 1 - y) * width * 4;
+		for (size_t c = 0; c < ExrChannels.size(); ++c)
+		{
+			uint16_t* channelLine = line.data() + c * width;
+			const uint8_t component = ExrChannels[c].second;
+			for (uint32_t x = 0; x < width; ++x)
+				channelLine[x] = row[x * 4 + component];
+		}
+
+		Write<int32_t>(stream, static_cast<int32_t>(y));
+		Write<int32_t>(stream, static_cast<int32_t>(lineSize));
+		stream.write(reinterpret_cast<const char*>(line.data()), lineSize);
+	}
+
+	return stream.good();
+}
\ No newline at end of file
@@ -0,0 +1,12 @@
+#pragma once
+
+#include <string>
+
+// Minimal OpenEXR writer for uncompressed scanline images with half float channels,
+// taking the half data as read back from the gpu without widening it to 32-bit.
+class ExrWriter
+{
+public:
+	// Writes interleaved rgba half floats, rows ordered bottom to top as in gl
+	static bool WriteHalfRGBA(const std::string& filepath, const uint16_t* pixels, uint32_t width, uint32_t height);
+};
\ No newline at end of file
@@ -0,0 +1,167 @@
+#include "svis_pch.h"
+#include "PixelReadback.h"
+
+#include <glad/glad.h>
+
+PixelReadback::PixelReadback()
+	: m_slots(),
+	m_writeIndex(0),
+	m_pendingCount(0),
+	m_prevPackAlignment(4)
+{
+}
+
+PixelReadback::~PixelReadback()
+{
+	Release();
+}
+
+bool PixelReadback::Queue(const Elysium::Shared<Elysium::FrameBuffer>& framebuffer, uint32_t width, uint32_t height, uint32_t tag)
+{
+	if (!HasFreeSlot())
+		return false;
+
+	BeginSlot(width * height * 4, tag);
+
+	// The copy lands in the pack buffer, returning immediately
+	framebuffer->Bind();
+	glReadBuffer(GL_COLOR_ATTACHMENT0);
+	glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+	framebuffer->Unbind();
+
+	SubmitSlot();
+	return true;
+}
+
+bool PixelReadback::QueueTexture(const Elysium::Shared<Elysium::Texture2D>& texture, uint32_t tag, PixelType type)
+{
+	if (!HasFreeSlot() || !texture)
+		return false;
+
+	const uint32_t componentSize = type == PixelType::HalfFloat ? 2 : 1;
+	const uint32_t size = texture->GetWidth() * texture->GetHeight() * 4 * componentSize;
+	BeginSlot(size, tag);
+
+	const GLenum glType = type == PixelType::HalfFloat ? GL_HALF_FLOAT : GL_UNSIGNED_BYTE;
+	glGetTextureImage(texture->GetRendererID(), 0, GL_RGBA, glType, size, nullptr);
+
+	SubmitSlot();
+	return true;
+}
+
+bool PixelReadback::TryCollect(std::vector<uint8_t>& pixels, uint32_t& tag)
+{
+	uint32_t size = 0;
+	const uint8_t* mapped = TryMapOldest(tag, size);
+	if (!mapped)
+		return false;
+
+	pixels.assign(mapped, mapped + size);
+	UnmapOldest();
+	return true;
+}
+
+uint8_t* PixelReadback::TryMapOldest(uint32_t& tag, uint32_t& size, bool writable)
+{
+	if (m_pendingCount == 0)
+		return nullptr;
+
+	Slot& slot = m_slots[GetReadIndex()];
+	if (slot.Mapped)
+		return nullptr;
+
+	// Poll without waiting, the result is picked up on a later frame otherwise
+	GLsync fence = static_cast<GLsync>(slot.Fence);
+	const GLenum status = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+	if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED)
+		return nullptr;
+
+	glDeleteSync(fence);
+	slot.Fence = nullptr;
+
+	const GLbitfield access = writable ? GL_MAP_READ_BIT | GL_MAP_WRITE_BIT : GL_MAP_READ_BIT;
+
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.Buffer);
+	void* mapped = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, slot.Size, access);
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+	if (!mapped)
+	{
+		// Drop the readback rather than retrying it forever
+		--m_pendingCount;
+		return nullptr;
+	}
+
+	slot.Mapped = true;
+	tag = slot.Tag;
+	size = slot.Size;
+	return static_cast<uint8_t*>(mapped);
+}
+
+void PixelReadback::UnmapOldest()
+{
+	if (m_pendingCount == 0)
+		return;
+
+	Slot& slot = m_slots[GetReadIndex()];
+	if (!slot.Mapped)
+		return;
+
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.Buffer);
+	glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+	slot.Mapped = false;
+	--m_pendingCount;
+}
+
+void PixelReadback::Release()
+{
+	for (Slot& slot : m_slots)
+	{
+		if (slot.Mapped)
+		{
+			glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.Buffer);
+			glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+			glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+		}
+		if (slot.Fence)
+			glDeleteSync(static_cast<GLsync>(slot.Fence));
+		if (slot.Buffer != 0)
+			glDeleteBuffers(1, &slot.Buffer);
+		slot = Slot();
+	}
+
+	m_writeIndex = 0;
+	m_pendingCount = 0;
+}
+
+void PixelReadback::BeginSlot(uint32_t size, uint32_t tag)
+{
+	Slot& slot = m_slots[m_writeIndex];
+	slot.Size = size;
+	slot.Tag = tag;
+
+	if (slot.Buffer == 0)
+		glGenBuffers(1, &slot.Buffer);
+
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.Buffer);
+	if (slot.Capacity < slot.Size)
+	{
+		glBufferData(GL_PIXEL_PACK_BUFFER, slot.Size, nullptr, GL_STREAM_READ);
+		slot.Capacity = slot.Size;
+	}
+	glGetIntegerv(GL_PACK_ALIGNMENT, &m_prevPackAlignment);
+	glPixelStorei(GL_PACK_ALIGNMENT, 1);
+}
+
+void PixelReadback::SubmitSlot()
+{
+	glPixelStorei(GL_PACK_ALIGNMENT, m_prevPackAlignment);
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+	m_slots[m_writeIndex].Fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+	m_writeIndex = (m_writeIndex + 1) % RingSize;
+	++m_pendingCount;
+}
\ No newline at end of file
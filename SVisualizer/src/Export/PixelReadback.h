@@ -0,0 +1,58 @@
+#pragma once
+
+#include "Elysium.h"
+
+// Reads framebuffer pixels back through a ring of pixel pack buffers, so the
+// copy is queued on the gpu and collected a few frames later without stalling.
+class PixelReadback
+{
+public:
+	static constexpr uint32_t RingSize = 3;
+
+	enum class PixelType : uint8_t
+	{
+		UnsignedByte,	// rgba8
+		HalfFloat		// rgba16f
+	};
+public:
+	PixelReadback();
+	~PixelReadback();
+public:
+	// Queues an rgba8 copy of the framebuffer's first color attachment, tagged for collection
+	bool Queue(const Elysium::Shared<Elysium::FrameBuffer>& framebuffer, uint32_t width, uint32_t height, uint32_t tag);
+
+	// Queues a copy of the whole texture, reading float targets at their native precision
+	bool QueueTexture(const Elysium::Shared<Elysium::Texture2D>& texture, uint32_t tag, PixelType type = PixelType::UnsignedByte);
+
+	// Copies out the oldest finished readback if one is available
+	bool TryCollect(std::vector<uint8_t>& pixels, uint32_t& tag);
+
+	// Maps the oldest finished readback without copying, its slot stays in use until UnmapOldest
+	uint8_t* TryMapOldest(uint32_t& tag, uint32_t& size, bool writable = false);
+	void UnmapOldest();
+	void Release();
+
+	inline bool HasFreeSlot() const { return m_pendingCount < RingSize; }
+	inline bool IsEmpty() const { return m_pendingCount == 0; }
+private:
+	inline uint32_t GetReadIndex() const { return (m_writeIndex + RingSize - m_pendingCount) % RingSize; }
+
+	void BeginSlot(uint32_t size, uint32_t tag);
+	void SubmitSlot();
+private:
+	struct Slot
+	{
+		uint32_t Buffer = 0;
+		uint32_t Capacity = 0;
+		uint32_t Size = 0;
+		uint32_t Tag = 0;
+		void* Fence = nullptr;
+		bool Mapped = false;
+	};
+	std::array<Slot, RingSize> m_slots;
+
+	uint32_t m_writeIndex;
+	uint32_t m_pendingCount;
+	// Pack alignment of the caller, put back once a slot is submitted
+	int32_t m_prevPackAlignment;
+};
\ No newline at end of file
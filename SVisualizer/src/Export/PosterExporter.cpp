@@ -0,0 +1,205 @@
+#include "svis_pch.h"
+#include "PosterExporter.h"
+
+#include "Rendering/PackageRenderer.h"
+#include "Rendering/RenderStateCache.h"
+#include "Rendering/BloomPyramid.h"
+
+PosterExporter::PosterExporter()
+	: m_time(0),
+	m_margin(0),
+	m_columns(0),
+	m_rows(0),
+	m_tileCount(0),
+	m_tilesRendered(0)
+{
+}
+
+PosterExporter::~PosterExporter()
+{
+	Cancel();
+}
+
+bool PosterExporter::Begin(const std::string& filepath, const PosterExportSettings& settings, const Elysium::Shared<Elysium::Shader>& shader, 
+						   const BufferPassShaders& bufferShaders, const PassSchedule& schedule, 
+						   const std::array<std::string, ShaderPackage::MaxTextureSlots>& textures, bool bloomEnabled, BloomFilterMode bloomMode, float time)
+{
+	Cancel();
+
+	if (!shader || filepath.empty())
+		return false;
+
+	m_settings = settings;
+	m_settings.Width = std::min(std::max(m_settings.Width, 1u), PosterExportSettings::MaxDimension);
+	m_settings.Height = std::min(std::max(m_settings.Height, 1u), PosterExportSettings::MaxDimension);
+	m_settings.TileSize = ClampTileSize(m_settings.TileSize);
+
+	if (!m_writer.Open(filepath, m_settings.Width, m_settings.Height, m_settings.TileSize))
+		return false;
+
+	m_filepath = filepath;
+	m_shader = shader;
+	m_time = time;
+	m_streamFrames = VideoStream::ReadSlotFrames(textures, m_time);
+
+	m_renderer = Elysium::CreateUnique<PackageRenderer>();
+	m_renderer->SetBloom(bloomEnabled, bloomMode);
+
+	// Every tile renders at the same padded size so the bloom chain matches across tiles. Padding can
+	// add bloom levels and with them reach, so grow it until it covers itself.
+	m_margin = 0;
+	uint32_t margin = 0;
+	do
+	{
+		m_margin = margin;
+		m_renderer->Resize(m_settings.TileSize + m_margin * 2, m_settings.TileSize + m_margin * 2);
+		margin = m_renderer->GetBloomMargin();
+	} while (margin > m_margin);
+
+	m_columns = (m_settings.Width + m_settings.TileSize - 1) / m_settings.TileSize;
+	m_rows = (m_settings.Height + m_settings.TileSize - 1) / m_settings.TileSize;
+
+	if (!schedule.IsEmpty())
+	{
+		// Buffers are sampled across the whole poster, so they are drawn at its size up to the tile limit
+		const float bufferScale = std::min(PosterExportSettings::MaxBufferDimension / static_cast<float>(std::max(m_settings.Width, m_settings.Height)), 1.0f);
+		m_bufferRenderer = Elysium::CreateUnique<PackageRenderer>();
+		m_bufferRenderer->Resize(static_cast<uint32_t>(m_settings.Width * bufferScale), static_cast<uint32_t>(m_settings.Height * bufferScale));
+		m_bufferRenderer->SetBufferPasses(bufferShaders, schedule);
+		m_bufferRenderer->SetPlaybackTime(m_time);
+
+		Elysium::CameraData& cameraRef = Elysium::CoreUniformBuffers::GetCameraDataRef();
+		const Elysium::Math::Vec4 prevViewport = cameraRef.m_viewport;
+		cameraRef.m_viewport = Elysium::Math::Vec4(static_cast<float>(m_settings.Width), static_cast<float>(m_settings.Height), 0, 0);
+		Elysium::CoreUniformBuffers::UploadDirtyData();
+
+		VideoStream::BindSlotFrames(m_streamFrames);
+		m_bufferRenderer->DrawBufferPasses(nullptr);
+
+		cameraRef.m_viewport = prevViewport;
+		Elysium::CoreUniformBuffers::UploadDirtyData();
+	}
+	m_tileCount = m_columns * m_rows;
+	m_tilesRendered = 0;
+
+	m_strip.resize(static_cast<size_t>(m_settings.Width) * m_settings.TileSize * 3);
+
+	ELYSIUM_INFO("Exporting {0}x{1} Poster in {2} Tiles to {3}", m_settings.Width, m_settings.Height, m_tileCount, filepath);
+	return true;
+}
+
+bool PosterExporter::Step()
+{
+	if (!IsActive())
+		return false;
+
+	RenderTile();
+
+	if (m_tilesRendered == m_tileCount)
+		Finish(true);
+
+	return IsActive();
+}
+
+void PosterExporter::Cancel()
+{
+	if (IsActive())
+		Finish(false);
+}
+
+uint32_t PosterExporter::ClampTileSize(uint32_t tileSize)
+{
+	constexpr uint32_t alignment = 1u << BloomPyramid::MaxLevels;
+	const uint32_t aligned = (tileSize + alignment / 2) / alignment * alignment;
+	return std::min(std::max(aligned, alignment), 4096u);
+}
+
+void PosterExporter::RenderTile()
+{
+	const uint32_t tileSize = m_settings.TileSize;
+	const uint32_t width = m_settings.Width;
+	const uint32_t height = m_settings.Height;
+
+	// Rows are exported top down to match the tiff strip order, while gl coordinates start at the bottom
+	const uint32_t row = m_tilesRendered / m_columns;
+	const uint32_t column = m_tilesRendered % m_columns;
+
+	const uint32_t rowTop = height - row * tileSize;
+	const uint32_t tileY = rowTop > tileSize ? rowTop - tileSize : 0;
+	const uint32_t tileHeight = rowTop - tileY;
+	const uint32_t tileX = column * tileSize;
+	const uint32_t tileWidth = std::min(tileSize, width - tileX);
+
+	// The shader sees the full poster through RESOLUTION, with its uvs offset to the padded tile
+	Elysium::CameraData& cameraRef = Elysium::CoreUniformBuffers::GetCameraDataRef();
+	const Elysium::Math::Vec4 prevViewport = cameraRef.m_viewport;
+	cameraRef.m_viewport = Elysium::Math::Vec4(static_cast<float>(width), static_cast<float>(height), 0, 0);
+	Elysium::CoreUniformBuffers::UploadDirtyData();
+
+	const float renderSize = static_cast<float>(tileSize + m_margin * 2);
+	const Elysium::Math::Vec4 region((static_cast<float>(tileX) - m_margin) / width, 
+									 (static_cast<float>(tileY) - m_margin) / height,
+									 renderSize / width, 
+									 renderSize / height);
+
+	float previewTime = 0.0f;
+	const bool hasPreviewTime = RenderStateCache::GetFloat(m_shader, "u_PlaybackTime", previewTime);
+
+	RenderStateCache::SetFloat(m_shader, "u_PlaybackTime", m_time);
+	RenderStateCache::SetFloat4(m_shader, "u_TileRegion", region);
+	if (m_bufferRenderer)
+		m_bufferRenderer->BindBuffers(m_shader);
+	// The editor rebinds the slots every frame, so the poster's frames are bound for each tile
+	VideoStream::BindSlotFrames(m_streamFrames);
+
+	m_renderer->Render(m_shader);
+
+	// Restore the preview state
+	RenderStateCache::SetFloat4(m_shader, "u_TileRegion", Elysium::Math::Vec4(0, 0, 1, 1));
+	if (hasPreviewTime)
+		RenderStateCache::SetFloat(m_shader, "u_PlaybackTime", previewTime);
+
+	cameraRef.m_viewport = prevViewport;
+	Elysium::CoreUniformBuffers::UploadDirtyData();
+
+	// Read back the tile without its margins, flipping it into the top down strip
+	const Elysium::Shared<Elysium::FrameBuffer>& output = m_renderer->GetOutput();
+	output->Bind();
+	uint8_t* pixelData = output->ReadPixelBuffer(0, m_margin, m_margin, tileWidth, tileHeight);
+	output->Unbind();
+
+	for (uint32_t y = 0; y < tileHeight; ++y)
+	{
+		const uint8_t* src = pixelData + static_cast<size_t>(y) * tileWidth * 4;
+		uint8_t* dst = m_strip.data() + (static_cast<size_t>(tileHeight - 1 - y) * width + tileX) * 3;
+		for (uint32_t x = 0; x < tileWidth; ++x)
+		{
+			dst[x * 3 + 0] = src[x * 4 + 0];
+			dst[x * 3 + 1] = src[x * 4 + 1];
+			dst[x * 3 + 2] = src[x * 4 + 2];
+		}
+	}
+	delete[] pixelData;
+
+	++m_tilesRendered;
+
+	if (column == m_columns - 1)
+		m_writer.WriteRows(m_strip.data(), tileHeight);
+}
+
+void PosterExporter::Finish(bool completed)
+{
+	const bool written = m_writer.Close() && completed;
+	if (written)
+		ELYSIUM_INFO("Finished Poster Export to {0}", m_filepath);
+	else
+		ELYSIUM_WARN("Poster Export to {0} Did Not Complete", m_filepath);
+
+	m_shader = nullptr;
+	m_renderer = nullptr;
+	m_bufferRenderer = nullptr;
+	m_streamFrames = {};
+
+	m_strip.clear();
+	m_strip.shrink_to_fit();
+}
\ No newline at end of file
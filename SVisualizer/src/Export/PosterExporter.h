@@ -0,0 +1,68 @@
+#pragma once
+
+#include "Elysium.h"
+
+#include "ShaderPackage.h"
+#include "Export/TiffStripWriter.h"
+#include "Textures/VideoStream.h"
+
+class PackageRenderer;
+
+struct PosterExportSettings
+{
+	static constexpr uint32_t MaxDimension = 32768;
+	// Largest side the buffer passes are drawn at for a poster
+	static constexpr uint32_t MaxBufferDimension = 4096;
+
+	uint32_t Width = 8192;
+	uint32_t Height = 8192;
+	uint32_t TileSize = 1024;
+};
+
+// Renders a shader package at resolutions beyond the framebuffer limits by drawing
+// it tile by tile, streaming each finished row of tiles out as a tiff strip.
+class PosterExporter
+{
+public:
+	PosterExporter();
+	~PosterExporter();
+public:
+	bool Begin(const std::string& filepath, const PosterExportSettings& settings, const Elysium::Shared<Elysium::Shader>& shader, 
+			   const BufferPassShaders& bufferShaders, const PassSchedule& schedule, 
+			   const std::array<std::string, ShaderPackage::MaxTextureSlots>& textures, bool bloomEnabled, BloomFilterMode bloomMode, float time);
+
+	// Renders the next tile, returns whether the export is still in progress
+	bool Step();
+	void Cancel();
+
+	inline bool IsActive() const { return m_shader != nullptr; }
+
+	// Keeps the tile size in range and a multiple of the coarsest bloom mip texel, so every tile's
+	// mip grid lines up with its neighbours'
+	static uint32_t ClampTileSize(uint32_t tileSize);
+	inline float GetProgress() const { return m_tileCount > 0 ? m_tilesRendered / static_cast<float>(m_tileCount) : 0.0f; }
+private:
+	void RenderTile();
+	void Finish(bool completed);
+private:
+	std::string m_filepath;
+	PosterExportSettings m_settings;
+	TiffStripWriter m_writer;
+
+	Elysium::Unique<PackageRenderer> m_renderer;
+	// Draws the buffer passes once for the whole poster, every tile samples them
+	Elysium::Unique<PackageRenderer> m_bufferRenderer;
+	Elysium::Shared<Elysium::Shader> m_shader;
+	// Streamed slots as they stand at the poster's time
+	VideoStream::SlotFrames m_streamFrames;
+	float m_time;
+	uint32_t m_margin;
+
+	uint32_t m_columns;
+	uint32_t m_rows;
+	uint32_t m_tileCount;
+	uint32_t m_tilesRendered;
+
+	// One row of tiles, top to bottom rgb
+	std::vector<uint8_t> m_strip;
+};
\ No newline at end of file
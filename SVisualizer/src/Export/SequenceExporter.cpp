@@ -0,0 +1,258 @@
+#include "svis_pch.h"
+#include "SequenceExporter.h"
+
+#include "Rendering/PackageRenderer.h"
+#include "Rendering/RenderStateCache.h"
+
+#include <opencv2/opencv.hpp>
+
+#include <filesystem>
+#include <iomanip>
+
+// Upper bound on frame memory waiting in the encode queue
+static constexpr size_t MaxQueuedBytes = 256ull * 1024 * 1024;
+
+SequenceExporter::SequenceExporter()
+	: m_width(0),
+	m_height(0),
+	m_framesRendered(0),
+	m_framesEncoded(0),
+	m_framesFailed(0),
+	m_encodeFailed(false),
+	m_pendingFrame(0),
+	m_hasPendingFrame(false)
+{
+}
+
+SequenceExporter::~SequenceExporter()
+{
+	Cancel();
+}
+
+bool SequenceExporter::Begin(const std::string& filepath, const SequenceExportSettings& settings, const Elysium::Shared<Elysium::Shader>& shader,
+							 const BufferPassShaders& bufferShaders, const PassSchedule& schedule,
+							 bool bloomEnabled, BloomFilterMode bloomMode, const Elysium::Math::iVec2& dimensions)
+{
+	Cancel();
+
+	if (!shader || filepath.empty())
+		return false;
+
+	m_settings = settings;
+	m_settings.FrameCount = std::max(m_settings.FrameCount, 1u);
+	m_settings.FrameRate = std::max(m_settings.FrameRate, 1.0f);
+
+	m_filepath = filepath;
+	if (!std::filesystem::path(m_filepath).has_extension())
+		m_filepath += m_settings.Format == SequenceFormat::Video ? ".mp4" : ".png";
+
+	m_width = std::max(dimensions.x, 1);
+	m_height = std::max(dimensions.y, 1);
+
+	uint32_t workerCount = std::max(std::thread::hardware_concurrency() / 2, 1u);
+	if (m_settings.Format == SequenceFormat::Video)
+	{
+		// Frames have to reach the writer in order, so video encodes on a single worker
+		workerCount = 1;
+
+		const std::string extension = std::filesystem::path(m_filepath).extension().string();
+		const int fourcc = extension == ".avi" ? cv::VideoWriter::fourcc('M', 'J', 'P', 'G') : cv::VideoWriter::fourcc('m', 'p', '4', 'v');
+
+		m_videoWriter = Elysium::CreateUnique<cv::VideoWriter>();
+		if (!m_videoWriter->open(m_filepath, fourcc, m_settings.FrameRate, cv::Size(m_width, m_height), true))
+		{
+			ELYSIUM_WARN("Error Opening Video Export File: {0}", m_filepath);
+			m_videoWriter = nullptr;
+			return false;
+		}
+	}
+
+	const size_t frameBytes = static_cast<size_t>(m_width) * m_height * 4;
+	const uint32_t capacity = static_cast<uint32_t>(std::min(std::max(MaxQueuedBytes / frameBytes, size_t(2)), size_t(16)));
+	m_encodeQueue.Start(workerCount, capacity);
+
+	m_shader = shader;
+
+	m_renderer = Elysium::CreateUnique<PackageRenderer>();
+	m_renderer->SetBloom(bloomEnabled, bloomMode);
+	m_renderer->Resize(m_width, m_height);
+	m_renderer->SetBufferPasses(bufferShaders, schedule);
+
+	m_framesRendered = 0;
+	m_framesEncoded = 0;
+	m_framesFailed = 0;
+	m_encodeFailed = false;
+	m_hasPendingFrame = false;
+
+	ELYSIUM_INFO("Exporting {0} Frames at {1} FPS to {2}", m_settings.FrameCount, m_settings.FrameRate, m_filepath);
+	return true;
+}
+
+bool SequenceExporter::Step()
+{
+	if (!IsActive())
+		return false;
+
+	if (m_encodeFailed)
+	{
+		Finish(false);
+		return false;
+	}
+
+	// Encode stage - hand finished readbacks to the workers until the queue is full
+	while (true)
+	{
+		if (!m_hasPendingFrame)
+		{
+			if (!m_readback.TryCollect(m_pendingPixels, m_pendingFrame))
+				break;
+			m_hasPendingFrame = true;
+		}
+
+		if (!PushPendingFrame())
+			break;
+	}
+
+	// Render stage - keep every readback slot busy
+	while (m_framesRendered < m_settings.FrameCount && m_readback.HasFreeSlot())
+		RenderFrame(m_framesRendered++);
+
+	const bool finished = m_framesRendered == m_settings.FrameCount && m_readback.IsEmpty() && 
+						  !m_hasPendingFrame && m_encodeQueue.IsIdle();
+	if (finished)
+		Finish(!m_encodeFailed);
+
+	return IsActive();
+}
+
+void SequenceExporter::Cancel()
+{
+	if (!IsActive())
+		return;
+
+	m_encodeQueue.Clear();
+	Finish(false);
+}
+
+void SequenceExporter::RenderFrame(uint32_t frame)
+{
+	// Fixed timestep rather than the wall clock
+	const float time = m_settings.StartTime + frame / m_settings.FrameRate;
+
+	// The program is shared with the preview, whose time is put back after the draw
+	float previewTime = 0.0f;
+	const bool hasPreviewTime = RenderStateCache::GetFloat(m_shader, "u_PlaybackTime", previewTime);
+
+	RenderStateCache::SetFloat(m_shader, "u_PlaybackTime", time);
+	m_renderer->SetPlaybackTime(time);
+
+	// The shader sees the export size through RESOLUTION, whatever the preview is at
+	Elysium::CameraData& cameraRef = Elysium::CoreUniformBuffers::GetCameraDataRef();
+	const Elysium::Math::Vec4 prevViewport = cameraRef.m_viewport;
+	cameraRef.m_viewport = Elysium::Math::Vec4(static_cast<float>(m_width), static_cast<float>(m_height), 0, 0);
+	Elysium::CoreUniformBuffers::UploadDirtyData();
+
+	m_renderer->DrawBufferPasses(m_shader);
+	m_renderer->Render(m_shader);
+
+	cameraRef.m_viewport = prevViewport;
+	Elysium::CoreUniformBuffers::UploadDirtyData();
+
+	if (hasPreviewTime)
+		RenderStateCache::SetFloat(m_shader, "u_PlaybackTime", previewTime);
+	m_readback.Queue(m_renderer->GetOutput(), m_width, m_height, frame);
+}
+
+bool SequenceExporter::PushPendingFrame()
+{
+	const uint32_t width = m_width;
+	const uint32_t height = m_height;
+	const uint32_t frame = m_pendingFrame;
+
+	// Jobs are copied around by the queue, so the pixels are shared rather than duplicated
+	auto pixels = std::make_shared<std::vector<uint8_t>>(std::move(m_pendingPixels));
+
+	EncodeQueue::Job job;
+	if (m_settings.Format == SequenceFormat::Video)
+	{
+		cv::VideoWriter* videoWriter = m_videoWriter.get();
+		job = [this, pixels, width, height, videoWriter]()
+		{
+			cv::Mat currentImage(height, width, CV_8UC4, pixels->data());
+
+			// Gl rows start at the bottom of the image
+			cv::Mat convertedImg;
+			cv::cvtColor(currentImage, convertedImg, cv::COLOR_RGBA2BGR);
+			cv::flip(convertedImg, convertedImg, 0);
+
+			videoWriter->write(convertedImg);
+			++m_framesEncoded;
+		};
+	}
+	else
+	{
+		const std::string framePath = GetFramePath(frame);
+		job = [this, pixels, width, height, framePath]()
+		{
+			cv::Mat currentImage(height, width, CV_8UC4, pixels->data());
+
+			// Gl rows start at the bottom of the image
+			cv::Mat convertedImg;
+			cv::cvtColor(currentImage, convertedImg, cv::COLOR_RGBA2BGRA);
+			cv::flip(convertedImg, convertedImg, 0);
+
+			if (!cv::imwrite(framePath, convertedImg))
+			{
+				ELYSIUM_WARN("Error Writing Frame to {0}", framePath);
+				++m_framesFailed;
+				m_encodeFailed = true;
+				return;
+			}
+			++m_framesEncoded;
+		};
+	}
+
+	if (!m_encodeQueue.TryPush(std::move(job)))
+	{
+		// Keep the frame for the next attempt
+		m_pendingPixels = std::move(*pixels);
+		return false;
+	}
+
+	m_hasPendingFrame = false;
+	return true;
+}
+
+void SequenceExporter::Finish(bool completed)
+{
+	// Wait on in-flight frames before closing the output
+	m_encodeQueue.Stop();
+
+	if (m_videoWriter)
+	{
+		m_videoWriter->release();
+		m_videoWriter = nullptr;
+	}
+
+	if (completed)
+		ELYSIUM_INFO("Finished Exporting {0} Frames to {1}", m_framesEncoded.load(), m_filepath);
+	else
+		ELYSIUM_WARN("Frame Export to {0} Did Not Complete ({1} Frames Written, {2} Failed)", m_filepath, m_framesEncoded.load(), m_framesFailed.load());
+
+	m_readback.Release();
+	m_shader = nullptr;
+	m_renderer = nullptr;
+
+	m_pendingPixels.clear();
+	m_pendingPixels.shrink_to_fit();
+	m_hasPendingFrame = false;
+}
+
+std::string SequenceExporter::GetFramePath(uint32_t frame) const
+{
+	// name.png -> name_0000.png
+	const std::filesystem::path path(m_filepath);
+	std::stringstream frameName;
+	frameName << path.stem().string() << "_" << std::setw(4) << std::setfill('0') << frame << path.extension().string();
+	return (path.parent_path() / frameName.str()).string();
+}
\ No newline at end of file
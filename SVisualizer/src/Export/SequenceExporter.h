@@ -0,0 +1,82 @@
+#pragma once
+
+#include "Elysium.h"
+
+#include "ShaderPackage.h"
+#include "Export/PixelReadback.h"
+#include "Export/EncodeQueue.h"
+
+#include <atomic>
+
+class PackageRenderer;
+
+namespace cv
+{
+	class VideoWriter;
+}
+
+enum class SequenceFormat : uint8_t
+{
+	PngSequence,
+	Video,
+
+	Count
+};
+
+struct SequenceExportSettings
+{
+	SequenceFormat Format = SequenceFormat::PngSequence;
+	uint32_t FrameCount = 120;
+	float FrameRate = 30.0f;
+	float StartTime = 0.0f;
+};
+
+// Exports an animation at a fixed timestep. Rendering, pixel readback and encoding
+// are pipelined across frames so throughput is bound by the slowest stage alone.
+class SequenceExporter
+{
+public:
+	SequenceExporter();
+	~SequenceExporter();
+public:
+	// Buffer passes run from a cleared history, feedback builds up over the exported frames
+	bool Begin(const std::string& filepath, const SequenceExportSettings& settings, const Elysium::Shared<Elysium::Shader>& shader,
+			   const BufferPassShaders& bufferShaders, const PassSchedule& schedule,
+			   bool bloomEnabled, BloomFilterMode bloomMode, const Elysium::Math::iVec2& dimensions);
+
+	// Advances every stage of the pipeline, returns whether the export is still in progress
+	bool Step();
+	void Cancel();
+
+	inline bool IsActive() const { return m_shader != nullptr; }
+	inline float GetProgress() const { return m_settings.FrameCount > 0 ? m_framesEncoded / static_cast<float>(m_settings.FrameCount) : 0.0f; }
+	inline uint32_t GetFramesEncoded() const { return m_framesEncoded; }
+private:
+	void RenderFrame(uint32_t frame);
+	bool PushPendingFrame();
+	void Finish(bool completed);
+
+	std::string GetFramePath(uint32_t frame) const;
+private:
+	std::string m_filepath;
+	SequenceExportSettings m_settings;
+
+	Elysium::Unique<PackageRenderer> m_renderer;
+	Elysium::Shared<Elysium::Shader> m_shader;
+	uint32_t m_width;
+	uint32_t m_height;
+
+	PixelReadback m_readback;
+	EncodeQueue m_encodeQueue;
+	Elysium::Unique<cv::VideoWriter> m_videoWriter;
+
+	uint32_t m_framesRendered;
+	std::atomic<uint32_t> m_framesEncoded;
+	std::atomic<uint32_t> m_framesFailed;
+	std::atomic<bool> m_encodeFailed;
+
+	// Collected frame waiting for room in the encode queue
+	std::vector<uint8_t> m_pendingPixels;
+	uint32_t m_pendingFrame;
+	bool m_hasPendingFrame;
+};
\ No newline at end of file
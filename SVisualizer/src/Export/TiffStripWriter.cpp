@@ -0,0 +1,160 @@
+#include "svis_pch.h"
+#include "TiffStripWriter.h"
+
+#include "Elysium.h"
+
+#include <limits>
+
+static constexpr uint16_t TiffShort = 3;
+static constexpr uint16_t TiffLong = 4;
+static constexpr uint16_t TiffRational = 5;
+
+static constexpr uint32_t SamplesPerPixel = 3;
+static constexpr uint32_t PrintResolution = 300;
+
+static void WriteU16(std::ofstream& stream, uint16_t value)
+{
+	const uint8_t bytes[2] = { static_cast<uint8_t>(value), static_cast<uint8_t>(value >> 8) };
+	stream.write(reinterpret_cast<const char*>(bytes), sizeof(bytes));
+}
+
+static void WriteU32(std::ofstream& stream, uint32_t value)
+{
+	const uint8_t bytes[4] = { static_cast<uint8_t>(value), static_cast<uint8_t>(value >> 8), 
+							   static_cast<uint8_t>(value >> 16), static_cast<uint8_t>(value >> 24) };
+	stream.write(reinterpret_cast<const char*>(bytes), sizeof(bytes));
+}
+
+static void WriteEntry(std::ofstream& stream, uint16_t tag, uint16_t type, uint32_t count, uint32_t valueOrOffset)
+{
+	WriteU16(stream, tag);
+	WriteU16(stream, type);
+	WriteU32(stream, count);
+
+	// Single short values are left aligned within the value field
+	if (type == TiffShort && count == 1)
+	{
+		WriteU16(stream, static_cast<uint16_t>(valueOrOffset));
+		WriteU16(stream, 0);
+	}
+	else
+	{
+		WriteU32(stream, valueOrOffset);
+	}
+}
+
+TiffStripWriter::TiffStripWriter()
+	: m_width(0),
+	m_height(0),
+	m_rowsWritten(0)
+{
+}
+
+TiffStripWriter::~TiffStripWriter()
+{
+	Close();
+}
+
+bool TiffStripWriter::Open(const std::string& filepath, uint32_t width, uint32_t height, uint32_t rowsPerStrip)
+{
+	const uint64_t stripSize = static_cast<uint64_t>(width) * rowsPerStrip * SamplesPerPixel;
+	const uint64_t imageSize = static_cast<uint64_t>(width) * height * SamplesPerPixel;
+	if (width == 0 || height == 0 || rowsPerStrip == 0 || imageSize + 4096 > std::numeric_limits<uint32_t>::max())
+	{
+		ELYSIUM_WARN("Tiff Export Unsupported Size: {0}x{1}", width, height);
+		return false;
+	}
+
+	m_stream.open(filepath, std::ios::binary | std::ios::trunc);
+	if (!m_stream.is_open())
+	{
+		ELYSIUM_WARN("Error Opening Tiff Export File: {0}", filepath);
+		return false;
+	}
+
+	m_width = width;
+	m_height = height;
+	m_rowsWritten = 0;
+
+	const uint32_t stripCount = (height + rowsPerStrip - 1) / rowsPerStrip;
+	const uint16_t entryCount = 13;
+
+	// Layout: header | ifd | bits per sample | resolutions | strip offsets | strip byte counts | image data
+	const uint32_t ifdOffset = 8;
+	const uint32_t bitsPerSampleOffset = ifdOffset + 2 + entryCount * 12 + 4;
+	const uint32_t xResolutionOffset = bitsPerSampleOffset + SamplesPerPixel * 2;
+	const uint32_t yResolutionOffset = xResolutionOffset + 8;
+	const uint32_t stripOffsetsOffset = yResolutionOffset + 8;
+	const uint32_t stripByteCountsOffset = stripOffsetsOffset + stripCount * 4;
+	const uint32_t imageOffset = stripByteCountsOffset + stripCount * 4;
+
+	// Single strip values are stored inline in the entry
+	const bool inlineStrips = stripCount == 1;
+
+	// Header
+	m_stream.write("II", 2);
+	WriteU16(m_stream, 42);
+	WriteU32(m_stream, ifdOffset);
+
+	// Image File Directory
+	WriteU16(m_stream, entryCount);
+	WriteEntry(m_stream, 256, TiffLong, 1, width);									// ImageWidth
+	WriteEntry(m_stream, 257, TiffLong, 1, height);									// ImageLength
+	WriteEntry(m_stream, 258, TiffShort, SamplesPerPixel, bitsPerSampleOffset);		// BitsPerSample
+	WriteEntry(m_stream, 259, TiffShort, 1, 1);										// Compression - none
+	WriteEntry(m_stream, 262, TiffShort, 1, 2);										// Photometric - rgb
+	WriteEntry(m_stream, 273, TiffLong, stripCount, inlineStrips ? imageOffset : stripOffsetsOffset);
+	WriteEntry(m_stream, 277, TiffShort, 1, SamplesPerPixel);						// SamplesPerPixel
+	WriteEntry(m_stream, 278, TiffLong, 1, rowsPerStrip);							// RowsPerStrip
+	WriteEntry(m_stream, 279, TiffLong, stripCount, inlineStrips ? static_cast<uint32_t>(imageSize) : stripByteCountsOffset);
+	WriteEntry(m_stream, 282, TiffRational, 1, xResolutionOffset);					// XResolution
+	WriteEntry(m_stream, 283, TiffRational, 1, yResolutionOffset);					// YResolution
+	WriteEntry(m_stream, 284, TiffShort, 1, 1);										// PlanarConfiguration - chunky
+	WriteEntry(m_stream, 296, TiffShort, 1, 2);										// ResolutionUnit - inch
+	WriteU32(m_stream, 0);
+
+	for (uint32_t i = 0; i < SamplesPerPixel; ++i)
+		WriteU16(m_stream, 8);
+
+	WriteU32(m_stream, PrintResolution);
+	WriteU32(m_stream, 1);
+	WriteU32(m_stream, PrintResolution);
+	WriteU32(m_stream, 1);
+
+	for (uint32_t i = 0; i < stripCount; ++i)
+		WriteU32(m_stream, imageOffset + static_cast<uint32_t>(stripSize * i));
+
+	for (uint32_t i = 0; i < stripCount; ++i)
+	{
+		const uint32_t stripRows = std::min(rowsPerStrip, height - i * rowsPerStrip);
+		WriteU32(m_stream, width * stripRows * SamplesPerPixel);
+	}
+
+	// Pad up to the image data, only written when the strip arrays were inlined
+	while (static_cast<uint32_t>(m_stream.tellp()) < imageOffset)
+		m_stream.put(0);
+
+	return m_stream.good();
+}
+
+bool TiffStripWriter::WriteRows(const uint8_t* rows, uint32_t rowCount)
+{
+	if (!m_stream.is_open() || m_rowsWritten + rowCount > m_height)
+		return false;
+
+	m_stream.write(reinterpret_cast<const char*>(rows), static_cast<std::streamsize>(m_width) * rowCount * SamplesPerPixel);
+	m_rowsWritten += rowCount;
+
+	return m_stream.good();
+}
+
+bool TiffStripWriter::Close()
+{
+	if (!m_stream.is_open())
+		return false;
+
+	const bool complete = m_rowsWritten == m_height && m_stream.good();
+	m_stream.close();
+
+	return complete;
+}
\ No newline at end of file
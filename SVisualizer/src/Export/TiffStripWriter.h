@@ -0,0 +1,28 @@
+#pragma once
+
+#include <fstream>
+#include <string>
+
+// Streams an uncompressed 8-bit RGB baseline TIFF to disk strip by strip,
+// so the full image never has to be held in memory.
+class TiffStripWriter
+{
+public:
+	TiffStripWriter();
+	~TiffStripWriter();
+public:
+	bool Open(const std::string& filepath, uint32_t width, uint32_t height, uint32_t rowsPerStrip);
+
+	// Appends tightly packed RGB rows, ordered top to bottom
+	bool WriteRows(const uint8_t* rows, uint32_t rowCount);
+	bool Close();
+
+	inline bool IsOpen() const { return m_stream.is_open(); }
+	inline uint32_t GetRowsWritten() const { return m_rowsWritten; }
+private:
+	std::ofstream m_stream;
+
+	uint32_t m_width;
+	uint32_t m_height;
+	uint32_t m_rowsWritten;
+};
\ No newline at end of file
@@ -0,0 +1,253 @@
+#include "svis_pch.h"
+#include "FileWatcher.h"
+
+#include "Elysium.h"
+
+#include <filesystem>
+#include <cstring>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <poll.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+static std::string NormalizePath(const std::string& filepath)
+{
+	std::error_code error;
+	const fs::path absolutePath = fs::absolute(filepath, error);
+	return (error ? fs::path(filepath) : absolutePath).lexically_normal().string();
+}
+
+FileWatcher::FileWatcher()
+	: m_inotifyFd(-1),
+	m_wakePipe{ -1, -1 },
+	m_hasChanges(false),
+	m_stopping(false)
+{
+#ifdef __linux__
+	m_inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	if (m_inotifyFd >= 0 && pipe2(m_wakePipe, O_NONBLOCK | O_CLOEXEC) != 0)
+	{
+		close(m_inotifyFd);
+		m_inotifyFd = -1;
+	}
+
+	if (m_inotifyFd >= 0)
+		m_worker = std::thread(&FileWatcher::WorkerLoop, this);
+	else
+		ELYSIUM_WARN("Failed to Create File Watcher, External Changes Won't be Reloaded.");
+#endif
+}
+
+FileWatcher::~FileWatcher()
+{
+#ifdef __linux__
+	if (m_worker.joinable())
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_stopping = true;
+		}
+		const char wake = 1;
+		(void)!write(m_wakePipe[1], &wake, 1);
+		m_worker.join();
+	}
+
+	if (m_inotifyFd >= 0)
+		close(m_inotifyFd);
+	if (m_wakePipe[0] >= 0)
+		close(m_wakePipe[0]);
+	if (m_wakePipe[1] >= 0)
+		close(m_wakePipe[1]);
+#endif
+}
+
+void FileWatcher::SetFiles(const std::vector<std::string>& filepaths)
+{
+	if (!IsSupported())
+		return;
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	m_files.clear();
+	std::unordered_set<std::string> directories;
+	for (const std::string& filepath : filepaths)
+	{
+		if (filepath.empty())
+			continue;
+
+		const std::string normalized = NormalizePath(filepath);
+		m_files[normalized] = filepath;
+		directories.insert(fs::path(normalized).parent_path().string());
+	}
+
+	// Changes still settling for files that are no longer watched aren't wanted anymore
+	for (auto it = m_pending.begin(); it != m_pending.end();)
+	{
+		if (m_files.find(it->first) == m_files.end())
+			it = m_pending.erase(it);
+		else
+			++it;
+	}
+
+#ifdef __linux__
+	for (auto it = m_directoryWatches.begin(); it != m_directoryWatches.end();)
+	{
+		if (directories.find(it->first) == directories.end())
+		{
+			inotify_rm_watch(m_inotifyFd, it->second);
+			m_watchDirectories.erase(it->second);
+			it = m_directoryWatches.erase(it);
+		}
+		else
+			++it;
+	}
+#endif
+
+	for (const std::string& directory : directories)
+	{
+		if (m_directoryWatches.find(directory) == m_directoryWatches.end())
+			AddDirectoryWatch(directory);
+	}
+}
+
+bool FileWatcher::TakeChanges(std::vector<std::string>& changed)
+{
+	if (!m_hasChanges.load(std::memory_order_acquire))
+		return false;
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	changed.insert(changed.end(), m_changed.begin(), m_changed.end());
+	m_changed.clear();
+	m_hasChanges.store(false, std::memory_order_release);
+	return !changed.empty();
+}
+
+void FileWatcher::WorkerLoop()
+{
+#ifdef __linux__
+	while (true)
+	{
+		// Sleep until an event arrives or the next pending change has settled
+		int timeoutMs = -1;
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			if (m_stopping)
+				break;
+
+			const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+			for (const auto& [path, settleTime] : m_pending)
+			{
+				const int untilSettled = static_cast<int>(std::chrono::ceil<std::chrono::milliseconds>(settleTime - now).count());
+				timeoutMs = timeoutMs < 0 ? std::max(untilSettled, 0) : std::min(timeoutMs, std::max(untilSettled, 0));
+			}
+		}
+
+		pollfd fds[2] = {};
+		fds[0].fd = m_inotifyFd;
+		fds[0].events = POLLIN;
+		fds[1].fd = m_wakePipe[0];
+		fds[1].events = POLLIN;
+		if (poll(fds, 2, timeoutMs) < 0 && errno != EINTR)
+		{
+			ELYSIUM_WARN("File Watcher Stopped: {0}", std::strerror(errno));
+			break;
+		}
+
+		const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+		if (fds[0].revents & POLLIN)
+			ReadEvents(now);
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+		bool settled = false;
+		for (auto it = m_pending.begin(); it != m_pending.end();)
+		{
+			if (it->second > now)
+			{
+				++it;
+				continue;
+			}
+
+			const auto file = m_files.find(it->first);
+			if (file != m_files.end())
+			{
+				m_changed.push_back(file->second);
+				settled = true;
+			}
+			it = m_pending.erase(it);
+		}
+
+		if (settled)
+			m_hasChanges.store(true, std::memory_order_release);
+	}
+#endif
+}
+
+void FileWatcher::ReadEvents(std::chrono::steady_clock::time_point now)
+{
+#ifdef __linux__
+	alignas(inotify_event) char buffer[4096];
+	while (true)
+	{
+		const ssize_t length = read(m_inotifyFd, buffer, sizeof(buffer));
+		if (length <= 0)
+			break;
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+		for (ssize_t offset = 0; offset < length;)
+		{
+			const inotify_event* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+			offset += sizeof(inotify_event) + event->len;
+
+			// Events were lost, any of the files may have changed
+			if (event->mask & IN_Q_OVERFLOW)
+			{
+				for (const auto& [path, original] : m_files)
+					m_pending[path] = now + SettleDelay;
+				continue;
+			}
+
+			const auto directory = m_watchDirectories.find(event->wd);
+			if (directory == m_watchDirectories.end())
+				continue;
+
+			// The directory itself was removed, along with its watch
+			if (event->mask & IN_IGNORED)
+			{
+				m_directoryWatches.erase(directory->second);
+				m_watchDirectories.erase(directory);
+				continue;
+			}
+
+			if (event->len == 0)
+				continue;
+
+			// Every further event for the file pushes its change back
+			const std::string path = (fs::path(directory->second) / event->name).string();
+			if (m_files.find(path) != m_files.end())
+				m_pending[path] = now + SettleDelay;
+		}
+	}
+#endif
+}
+
+void FileWatcher::AddDirectoryWatch(const std::string& directory)
+{
+#ifdef __linux__
+	// Written in place, renamed over or deleted and recreated
+	const uint32_t mask = IN_MODIFY | IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_DELETE;
+	const int watch = inotify_add_watch(m_inotifyFd, directory.c_str(), mask);
+	if (watch < 0)
+	{
+		ELYSIUM_WARN("Failed to Watch Directory {0}: {1}", directory, std::strerror(errno));
+		return;
+	}
+
+	m_watchDirectories[watch] = directory;
+	m_directoryWatches[directory] = watch;
+#endif
+}
\ No newline at end of file
@@ -0,0 +1,46 @@
+#pragma once
+
+// Reports changes made to a set of files from outside the application, without polling them.
+// The parent directories are watched rather than the files, so editors that save by writing a
+// new file and renaming it over the old one are picked up as well. A worker thread sleeps on the
+// change notifications and coalesces each burst of events for a file (truncate, writes, close)
+// into a single change, handed out once the file has been quiet for SettleDelay.
+// Backed by inotify, other platforms report no changes.
+class FileWatcher
+{
+public:
+	static constexpr std::chrono::milliseconds SettleDelay = std::chrono::milliseconds(150);
+public:
+	FileWatcher();
+	~FileWatcher();
+public:
+	// Replaces the watched files, empty paths are skipped
+	void SetFiles(const std::vector<std::string>& filepaths);
+
+	// Hands out the files that changed since the last call, as they were passed to SetFiles.
+	// Never blocks and costs no system call while nothing has changed.
+	bool TakeChanges(std::vector<std::string>& changed);
+
+	inline bool IsSupported() const { return m_inotifyFd >= 0; }
+private:
+	void WorkerLoop();
+	void ReadEvents(std::chrono::steady_clock::time_point now);
+	void AddDirectoryWatch(const std::string& directory);
+private:
+	int m_inotifyFd;
+	// Written to on shutdown to wake the worker
+	int m_wakePipe[2];
+	std::thread m_worker;
+
+	std::mutex m_mutex;
+	// Normalized path to the path the caller knows the file by
+	std::unordered_map<std::string, std::string> m_files;
+	std::unordered_map<int, std::string> m_watchDirectories;
+	std::unordered_map<std::string, int> m_directoryWatches;
+
+	// Files still receiving events, with the time they count as settled
+	std::unordered_map<std::string, std::chrono::steady_clock::time_point> m_pending;
+	std::vector<std::string> m_changed;
+	std::atomic<bool> m_hasChanges;
+	bool m_stopping;
+};
\ No newline at end of file
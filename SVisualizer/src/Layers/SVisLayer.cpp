@@ -4,6 +4,13 @@
 
 #include "Panels/ViewerPanel.h"
 #include "Panels/ShaderEditorPanel.h"
+#include "Panels/ProfilerPanel.h"
+
+#include "Profiling/FrameProfiler.h"
+#include "Rendering/ProgramBinaryCache.h"
+#include "Rendering/RenderStateCache.h"
+#include "Rendering/RenderTargetPool.h"
+#include "Textures/TextureCache.h"
 
 #include "Elysium/Factories/ShaderFactory.h"
 
@@ -12,7 +19,9 @@
 SVisLayer::SVisLayer()
 	: m_viewerPanel(nullptr),
 	m_editorPanel(nullptr),
-	m_modifierKeyFlag(0)
+	m_profilerPanel(nullptr),
+	m_modifierKeyFlag(0),
+	m_frameStart(std::chrono::steady_clock::now())
 {
 }
 
@@ -22,29 +31,60 @@ SVisLayer::~SVisLayer()
 
 void SVisLayer::OnAttach()
 {
+	// Before any panel creates its shaders
+	ProgramBinaryCache::Init("Cache/Programs");
+
 	m_package = Elysium::CreateUnique<ShaderPackage>();
 
 	m_editorPanel = Elysium::CreateUnique<ShaderEditorPanel>(m_package.get());
 	m_viewerPanel = Elysium::CreateUnique<ViewerPanel>(m_package.get());
+	m_profilerPanel = Elysium::CreateUnique<ProfilerPanel>();
 }
 
 void SVisLayer::OnDetach()
 {
 	m_editorPanel = nullptr;
 	m_viewerPanel = nullptr;
+	m_profilerPanel = nullptr;
+
+	FrameProfiler::Shutdown();
+	ProgramBinaryCache::Shutdown();
+	TextureCache::Shutdown();
+	RenderTargetPool::Shutdown();
 }
 
 void SVisLayer::OnUpdate()
 {
-	m_viewerPanel->OnUpdate();
-	m_editorPanel->OnUpdate();
+	FrameProfiler::BeginFrame();
+	{
+		SVIS_PROFILE_GPU_SCOPE("Layer Update");
+		{
+			SVIS_PROFILE_SCOPE("Viewer Update");
+			m_viewerPanel->OnUpdate();
+		}
+		{
+			SVIS_PROFILE_SCOPE("Editor Update");
+			m_editorPanel->SetPlaybackTime(m_viewerPanel->GetPlaybackTime());
+			m_editorPanel->OnUpdate();
+		}
+		{
+			// TODO:: Move into appropriate pass?
+			SVIS_PROFILE_GPU_SCOPE("Upload Uniforms");
+			Elysium::CoreUniformBuffers::UploadDirtyData();
+		}
 
-	// TODO:: Move into appropriate pass?
-	Elysium::CoreUniformBuffers::UploadDirtyData();
+		ShaderVariants currentShaders;
+		{
+			SVIS_PROFILE_GPU_SCOPE("Bind Shader Inputs");
+			m_editorPanel->GetCurrentShaders(currentShaders);
+		}
+		m_viewerPanel->DrawTo(currentShaders);
+	}
+	FrameProfiler::EndFrame();
+	RenderStateCache::EndFrame();
+	RenderTargetPool::EndFrame();
 
-	Elysium::Shared<Elysium::Shader> currentShader = nullptr;
-	m_editorPanel->GetCurrentShader(currentShader);
-	m_viewerPanel->DrawTo(currentShader);
+	ThrottleIdleFrame();
 }
 
 void SVisLayer::OnImGuiRender()
@@ -103,6 +143,7 @@ void SVisLayer::OnImGuiRender()
 
 	m_viewerPanel->OnImGuiRender();
 	m_editorPanel->OnImGuiRender();
+	m_profilerPanel->OnImGuiRender();
 
 	ImGui::End();
 
@@ -170,6 +211,11 @@ bool SVisLayer::OnKeyPressed(Elysium::KeyPressedEvent& _event)
 			m_editorPanel->Compile();
 			return true;
 		}
+		case Elysium::Key::F3:
+		{
+			m_profilerPanel->SetVisible(!m_profilerPanel->IsVisible());
+			return true;
+		}
 	}
 	return false;
 }
@@ -193,3 +239,33 @@ bool SVisLayer::OnKeyReleased(Elysium::KeyReleasedEvent& _event)
 	}
 	return false;
 }
+
+bool SVisLayer::IsInteracting() const
+{
+	const ImGuiIO& io = ImGui::GetIO();
+	if (io.WantTextInput || ImGui::IsAnyItemActive())
+		return true;
+
+	if (io.MouseDelta.x != 0.0f || io.MouseDelta.y != 0.0f || io.MouseWheel != 0.0f)
+		return true;
+
+	for (bool mouseDown : io.MouseDown)
+	{
+		if (mouseDown)
+			return true;
+	}
+	return false;
+}
+
+void SVisLayer::ThrottleIdleFrame()
+{
+	// Drop to the idle frame rate while the viewer is left alone to free up the gpu
+	if (m_viewerPanel->IsIdle() && !IsInteracting())
+	{
+		const auto idleFrameTime = std::chrono::microseconds(1000000 / m_viewerPanel->GetIdleFrameRate());
+		const auto elapsed = std::chrono::steady_clock::now() - m_frameStart;
+		if (elapsed < idleFrameTime)
+			std::this_thread::sleep_for(idleFrameTime - elapsed);
+	}
+	m_frameStart = std::chrono::steady_clock::now();
+}
\ No newline at end of file
@@ -7,6 +7,7 @@
 
 class ViewerPanel;
 class ShaderEditorPanel;
+class ProfilerPanel;
 
 class SVisLayer : public Elysium::Layer
 {
@@ -30,13 +31,19 @@ public:
 private:
 	bool OnKeyPressed(Elysium::KeyPressedEvent& _event);
 	bool OnKeyReleased(Elysium::KeyReleasedEvent& _event);
+
+	bool IsInteracting() const;
+	void ThrottleIdleFrame();
 private:
 	Elysium::Unique<ViewerPanel> m_viewerPanel;
 	Elysium::Unique<ShaderEditorPanel> m_editorPanel;
+	Elysium::Unique<ProfilerPanel> m_profilerPanel;
 
 	Elysium::Unique<ShaderPackage> m_package;
 
 	Elysium::Shared<Elysium::Shader> m_defaultShader;
 
 	short m_modifierKeyFlag;
+
+	std::chrono::steady_clock::time_point m_frameStart;
 };
@@ -0,0 +1,264 @@
+#include "svis_pch.h"
+#include "ProfilerPanel.h"
+
+#include "Profiling/FrameProfiler.h"
+#include "Rendering/ProgramBinaryCache.h"
+#include "Rendering/RenderStateCache.h"
+#include "Rendering/RenderTargetPool.h"
+#include "Textures/TextureCache.h"
+
+#include <imgui.h>
+#include <imgui_internal.h>
+
+static void DrawProgramCache(const ImVec4& titleColor)
+{
+	ImGui::TextColored(titleColor, "Program Cache");
+	if (!ProgramBinaryCache::IsEnabled())
+	{
+		ImGui::TextDisabled("Disabled, program binaries are not available on this driver.");
+		return;
+	}
+
+	const ProgramBinaryCache::Statistics stats = ProgramBinaryCache::GetStatistics();
+	const uint32_t lookups = stats.Hits + stats.Misses;
+	const float hitRate = lookups > 0 ? 100.0f * stats.Hits / lookups : 0.0f;
+
+	ImGui::Text("Hits: %u  Misses: %u  (%.0f%%)", stats.Hits, stats.Misses, hitRate);
+	ImGui::Text("Stored: %u  Rejected: %u  Evicted: %u", stats.Stores, stats.Rejected, stats.Evictions);
+	ImGui::Text("Entries: %u  Size: %.2f MB", stats.EntryCount, stats.TotalBytes / (1024.0f * 1024.0f));
+
+	ImGui::Text("Max Size:");
+	ImGui::SameLine();
+	ImGui::TextDisabled("(?)");
+	if (ImGui::IsItemHovered())
+	{
+		ImGui::BeginTooltip();
+		ImGui::PushTextWrapPos(ImGui::GetFontSize() * 35.0f);
+		ImGui::TextUnformatted("Least Recently Used Binaries are Evicted once the Cache Grows Past this Size.");
+		ImGui::PopTextWrapPos();
+		ImGui::EndTooltip();
+	}
+	ImGui::SameLine();
+
+	int maxSizeMB = static_cast<int>(ProgramBinaryCache::GetMaxSize() / (1024ull * 1024ull));
+	ImGui::PushItemWidth(120.0f);
+	if (ImGui::InputInt("MB##programcache", &maxSizeMB, 16, 64))
+		ProgramBinaryCache::SetMaxSize(static_cast<uint64_t>(std::max(maxSizeMB, 1)) * 1024ull * 1024ull);
+	ImGui::PopItemWidth();
+
+	ImGui::SameLine();
+	if (ImGui::Button("Clear##programcache"))
+		ProgramBinaryCache::Clear();
+}
+
+static void DrawTextureCache(const ImVec4& titleColor)
+{
+	ImGui::TextColored(titleColor, "Texture Cache");
+
+	const TextureCache::Statistics stats = TextureCache::GetStatistics();
+	const uint32_t lookups = stats.Hits + stats.Misses;
+	const float hitRate = lookups > 0 ? 100.0f * stats.Hits / lookups : 0.0f;
+
+	ImGui::Text("Hits: %u  Misses: %u  (%.0f%%)  Evicted: %u", stats.Hits, stats.Misses, hitRate, stats.Evictions);
+	ImGui::Text("Entries: %u  In Use: %u  Resident: %.2f MB", stats.EntryCount, stats.ReferencedCount, stats.ResidentBytes / (1024.0f * 1024.0f));
+
+	ImGui::Text("Budget:");
+	ImGui::SameLine();
+	ImGui::TextDisabled("(?)");
+	if (ImGui::IsItemHovered())
+	{
+		ImGui::BeginTooltip();
+		ImGui::PushTextWrapPos(ImGui::GetFontSize() * 35.0f);
+		ImGui::TextUnformatted("Least Recently Used Images no Slot is Using are Evicted once the Cache Grows Past this Size.");
+		ImGui::PopTextWrapPos();
+		ImGui::EndTooltip();
+	}
+	ImGui::SameLine();
+
+	int budgetMB = static_cast<int>(TextureCache::GetBudget() / (1024ull * 1024ull));
+	ImGui::PushItemWidth(120.0f);
+	if (ImGui::InputInt("MB##texturecache", &budgetMB, 16, 128))
+		TextureCache::SetBudget(static_cast<uint64_t>(std::max(budgetMB, 1)) * 1024ull * 1024ull);
+	ImGui::PopItemWidth();
+
+	ImGui::SameLine();
+	if (ImGui::Button("Clear Unused##texturecache"))
+		TextureCache::ClearUnused();
+}
+
+static void DrawRenderTargets(const ImVec4& titleColor)
+{
+	ImGui::TextColored(titleColor, "Render Targets");
+
+	const RenderTargetPool::Statistics stats = RenderTargetPool::GetStatistics();
+	const float toMB = 1.0f / (1024.0f * 1024.0f);
+
+	ImGui::Text("Targets: %u  Held: %u  Allocated: %.2f MB  Held: %.2f MB", 
+				stats.TargetCount, stats.InUseCount, stats.AllocatedBytes * toMB, stats.InUseBytes * toMB);
+	ImGui::Text("Frame Peak: %.2f MB", stats.FramePeakBytes * toMB);
+	ImGui::SameLine();
+	ImGui::TextDisabled("(?)");
+	if (ImGui::IsItemHovered())
+	{
+		ImGui::BeginTooltip();
+		ImGui::PushTextWrapPos(ImGui::GetFontSize() * 35.0f);
+		ImGui::TextUnformatted("Most Memory in Use at Once Last Frame. Blur Targets are Only Borrowed while the Post Passes Run, "
+							   "Targets Nobody Used for a Few Frames are Destroyed.");
+		ImGui::PopTextWrapPos();
+		ImGui::EndTooltip();
+	}
+	ImGui::Text("Created: %u  Reused: %u  Destroyed: %u", stats.Created, stats.Reused, stats.Destroyed);
+
+	if (ImGui::Button("Reset##rendertargets"))
+		RenderTargetPool::ResetCounters();
+	ImGui::SameLine();
+	if (ImGui::Button("Release Unused##rendertargets"))
+		RenderTargetPool::ReleaseUnused();
+}
+
+static void DrawRenderState(const ImVec4& titleColor)
+{
+	ImGui::TextColored(titleColor, "Render State");
+
+	ImGui::Columns(5, "RenderStateColumns", false);
+	ImGui::Text("State");		ImGui::NextColumn();
+	ImGui::Text("Issued");		ImGui::NextColumn();
+	ImGui::Text("Skipped");		ImGui::NextColumn();
+	ImGui::Text("Total Issued");	ImGui::NextColumn();
+	ImGui::Text("Total Skipped");	ImGui::NextColumn();
+
+	const char* stateNames[] = { "Texture Binds", "Uniforms" };
+	for (uint8_t i = 0; i < (uint8_t)RenderStateCache::StateType::Count; ++i)
+	{
+		const RenderStateCache::StateType type = static_cast<RenderStateCache::StateType>(i);
+		const RenderStateCache::Counters frame = RenderStateCache::GetFrameCounters(type);
+		const RenderStateCache::Counters total = RenderStateCache::GetTotalCounters(type);
+
+		ImGui::Text(stateNames[i]);			ImGui::NextColumn();
+		ImGui::Text("%u", frame.Issued);	ImGui::NextColumn();
+		ImGui::Text("%u", frame.Skipped);	ImGui::NextColumn();
+		ImGui::Text("%u", total.Issued);	ImGui::NextColumn();
+		ImGui::Text("%u", total.Skipped);	ImGui::NextColumn();
+	}
+	ImGui::Columns(1);
+
+	if (ImGui::Button("Reset##renderstate"))
+		RenderStateCache::ResetCounters();
+	ImGui::SameLine();
+	ImGui::TextColored(titleColor, "Calls over the last frame and since the last reset.");
+}
+
+ProfilerPanel::ProfilerPanel()
+	: m_visible(false)
+{
+}
+
+ProfilerPanel::~ProfilerPanel()
+{
+	FrameProfiler::SetEnabled(false);
+}
+
+void ProfilerPanel::SetVisible(bool visible)
+{
+	m_visible = visible;
+
+	// Only pay for the timers and queries while someone is looking at them
+	FrameProfiler::SetEnabled(m_visible);
+}
+
+void ProfilerPanel::OnImGuiRender()
+{
+	if (!m_visible)
+		return;
+
+	ImGuiWindowClass window_class;
+	window_class.DockNodeFlagsOverrideSet = ImGuiDockNodeFlags_NoTabBar;
+	ImGui::SetNextWindowClass(&window_class);
+
+	bool visible = m_visible;
+	if (ImGui::Begin("Profiler", &visible, ImGuiWindowFlags_NoCollapse | ImGuiWindowFlags_NoDocking))
+	{
+		const ImVec4 titleColor(0.5f, 0.5f, 0.5f, 1.0f);
+
+		// Frame Time Graph ------------------------
+		const SampleHistory& frameTimes = FrameProfiler::GetFrameTimes();
+		const float frameAverage = frameTimes.Average();
+		const float frameP99 = frameTimes.Percentile(99.0f);
+
+		ImGui::Text("Frame: %.2f ms (%.0f fps)", frameAverage, frameAverage > 0.0f ? 1000.0f / frameAverage : 0.0f);
+		ImGui::SameLine();
+		ImGui::TextColored(titleColor, "p50 %.2f  p95 %.2f  p99 %.2f", 
+						   frameTimes.Percentile(50.0f), frameTimes.Percentile(95.0f), frameP99);
+
+		frameTimes.CopyOrdered(m_plotSamples);
+		ImGui::PlotLines("##frametimes", m_plotSamples.data(), static_cast<int>(m_plotSamples.size()), 0, nullptr,
+						 0.0f, std::max(1000.0f / 30.0f, frameP99 * 1.2f), ImVec2(ImGui::GetContentRegionAvail().x, 80.0f));
+		// -----------------------------------------
+
+		ImGui::Spacing();
+		ImGui::Separator();
+
+		// Section Table ---------------------------
+		ImGui::Columns(6, "ProfilerSections", false);
+		ImGui::SetColumnWidth(0, 180.0f);
+
+		ImGui::TextColored(titleColor, "Section");	ImGui::NextColumn();
+		ImGui::TextColored(titleColor, "CPU avg");	ImGui::NextColumn();
+		ImGui::TextColored(titleColor, "CPU p95");	ImGui::NextColumn();
+		ImGui::TextColored(titleColor, "GPU avg");	ImGui::NextColumn();
+		ImGui::TextColored(titleColor, "GPU p95");	ImGui::NextColumn();
+		ImGui::TextColored(titleColor, "GPU p99");	ImGui::NextColumn();
+		ImGui::Separator();
+
+		for (const FrameProfiler::Section& section : FrameProfiler::GetSections())
+		{
+			ImGui::Indent(section.Depth * 10.0f + 1.0f);
+			ImGui::TextUnformatted(section.Name.c_str());
+			ImGui::Unindent(section.Depth * 10.0f + 1.0f);
+			ImGui::NextColumn();
+
+			ImGui::Text("%.3f", section.CpuTimes.Average());			ImGui::NextColumn();
+			ImGui::Text("%.3f", section.CpuTimes.Percentile(95.0f));	ImGui::NextColumn();
+
+			if (section.HasGpuTiming)
+			{
+				ImGui::Text("%.3f", section.GpuTimes.Average());			ImGui::NextColumn();
+				ImGui::Text("%.3f", section.GpuTimes.Percentile(95.0f));	ImGui::NextColumn();
+				ImGui::Text("%.3f", section.GpuTimes.Percentile(99.0f));	ImGui::NextColumn();
+			}
+			else
+			{
+				ImGui::TextDisabled("-");	ImGui::NextColumn();
+				ImGui::TextDisabled("-");	ImGui::NextColumn();
+				ImGui::TextDisabled("-");	ImGui::NextColumn();
+			}
+		}
+
+		ImGui::Columns(1);
+		ImGui::Separator();
+		// -----------------------------------------
+
+		if (ImGui::Button("Reset"))
+			FrameProfiler::Reset();
+
+		ImGui::SameLine();
+		ImGui::TextColored(titleColor, "Times in ms over the last %u samples. Dropped GPU results: %u", 
+						   SampleHistory::Capacity, FrameProfiler::GetDroppedGpuResults());
+
+		ImGui::Separator();
+		DrawProgramCache(titleColor);
+
+		ImGui::Separator();
+		DrawTextureCache(titleColor);
+
+		ImGui::Separator();
+		DrawRenderTargets(titleColor);
+
+		ImGui::Separator();
+		DrawRenderState(titleColor);
+	}
+	ImGui::End();
+
+	if (visible != m_visible)
+		SetVisible(visible);
+}
\ No newline at end of file
@@ -0,0 +1,19 @@
+#pragma once
+
+#include "Elysium.h"
+
+class ProfilerPanel
+{
+public:
+	ProfilerPanel();
+	~ProfilerPanel();
+public:
+	void OnImGuiRender();
+
+	inline bool IsVisible() const { return m_visible; }
+	void SetVisible(bool visible);
+private:
+	bool m_visible;
+
+	std::vector<float> m_plotSamples;
+};
\ No newline at end of file
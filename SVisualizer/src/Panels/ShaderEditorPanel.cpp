@@ -3,41 +3,65 @@
 #include "Panels/ShaderEditorPanel.h"
 
 #include "Elysium/Utils/FileUtils.h"
+#include "Elysium/Utils/YamlUtils.h"
 #include "Elysium/Factories/ShaderFactory.h"
 #include "Elysium/Renderer/RendererBase.h"
 
 #include "ShaderPackage.h"
 #include "ShaderPackageSerializer.h"
+#include "ShaderPackageCompiler.h"
+#include "BackgroundShaderCompiler.h"
+#include "FileWatcher.h"
+#include "Rendering/RenderStateCache.h"
+#include "Textures/AsyncTextureLoader.h"
+#include "Textures/TextureCache.h"
+#include "Textures/VideoStream.h"
 
 #include <TextEditor.h>
 #include <imgui_internal.h>
 
+static size_t HashCode(const std::string& code, const BufferPassCodes& bufferCode)
+{
+	size_t hash = std::hash<std::string>()(code);
+	for (const std::string& passCode : bufferCode)
+		hash = hash * 31 + std::hash<std::string>()(passCode);
+	return hash;
+}
+
 ShaderEditorPanel::ShaderEditorPanel(ShaderPackage* package)
 	: m_package(package),
-	m_savedShaderCode(),
+	m_editVersion(0),
+	m_trackedEditVersion(0),
+	m_currentCodeHash(0),
+	m_packageCodeHash(0),
+	m_savedCodeHash(0),
 	m_shaderCompileRequested(false),
 	m_shaderCompiled(false),
 	m_textChanged(false),
 	m_textFileChanged(false),
+	m_liveCompile(false),
+	m_liveCompilePending(false),
+	m_lastEditTime(std::chrono::steady_clock::now()),
 	m_currentFile(), 
 	m_currentFileName(),
-	m_imageEditorVisible(false)
+	m_passHasErrors(),
+	m_activePass(ImagePass),
+	m_imageEditorVisible(false),
+	m_playbackTime(0.0f)
 {
-	// Initialize the text editor
-	m_textEditor = Elysium::CreateUnique<TextEditor>();
-	
+	// Initialize the text editors
 	auto textLanguage = TextEditor::LanguageDefinition::GLSL();
-	m_textEditor->SetLanguageDefinition(textLanguage);
-	
-	m_textEditor->SetPalette(TextEditor::GetDarkPalette());
-	m_textEditor->SetShowWhitespaces(false);
-	
-	const std::string solvedFilepath = Elysium::FileUtils::GetAssetPath_Str("Content/shaders/default.shader");
-	std::ifstream defaultShaderStream(solvedFilepath);
-	if (defaultShaderStream.good())
-		m_baseShaderCode = std::move(std::string((std::istreambuf_iterator<char>(defaultShaderStream)), std::istreambuf_iterator<char>()));
-	else
-		ELYSIUM_ERROR("Error Opening Default Shader File!");
+	for (Elysium::Unique<TextEditor>& textEditor : m_textEditors)
+	{
+		textEditor = Elysium::CreateUnique<TextEditor>();
+		textEditor->SetLanguageDefinition(textLanguage);
+
+		textEditor->SetPalette(TextEditor::GetDarkPalette());
+		textEditor->SetShowWhitespaces(false);
+	}
+
+	m_backgroundCompiler = Elysium::CreateUnique<BackgroundShaderCompiler>(m_compiler);
+	m_fileWatcher = Elysium::CreateUnique<FileWatcher>();
 
 	m_defaultPixelShaderCode = "void PixelProcess(out vec4 pColor)\n{\n\tpColor = vec4(UVS.x, UVS.y, 0, 1.0);\n}";
 
@@ -56,22 +80,75 @@ ShaderEditorPanel::~ShaderEditorPanel()
 
 void ShaderEditorPanel::OnUpdate()
 {
-	std::string currentText = m_textEditor->GetText();
-	if (currentText != m_package->Code)
-		m_textChanged = true;
+	// Building the document text is linear in its size, only do it once the editor reported an edit
+	if (m_trackedEditVersion != m_editVersion)
+	{
+		m_trackedEditVersion = m_editVersion;
 
-	if (currentText != m_savedShaderCode)
-		m_textFileChanged = true;
+		std::string code;
+		BufferPassCodes bufferCode;
+		ReadEditorText(code, bufferCode);
+		m_currentCodeHash = HashCode(code, bufferCode);
+		UpdateChangeState();
+	}
 
 	if (m_shaderCompileRequested)
 	{
 		CompileShader();
 		m_shaderCompileRequested = false;
-		m_textChanged = false;
 
 		if (!m_currentFile.empty())
 			SaveCurrentCode();
 	}
+
+	// Live mode waits for a pause in typing, validation on the worker keeps broken code away from the driver link
+	if (m_liveCompile && m_liveCompilePending && !m_backgroundCompiler->IsCompiling())
+	{
+		if (std::chrono::steady_clock::now() - m_lastEditTime >= LiveCompileDelay)
+		{
+			m_liveCompilePending = false;
+
+			std::string code;
+			BufferPassCodes bufferCode;
+			ReadEditorText(code, bufferCode);
+			m_backgroundCompiler->Request(code, bufferCode, true);
+		}
+	}
+
+	// Edits made in other programs, only the parts that changed are reloaded
+	UpdateWatchedFiles();
+	std::vector<std::string> changedFiles;
+	if (m_fileWatcher->TakeChanges(changedFiles))
+		ApplyExternalChanges(changedFiles);
+
+	bool streamFrameChanged = false;
+	if (m_loadedImages.Update(m_playbackTime, streamFrameChanged))
+		++m_package->Revision;
+	if (streamFrameChanged)
+		++m_package->StreamRevision;
+
+	// Swap in finished compiles, failed ones leave the last good shaders rendering
+	BackgroundShaderCompiler::Result compileResult;
+	if (m_backgroundCompiler->TryGetResult(compileResult))
+	{
+		if (compileResult.Success)
+		{
+			m_package->Code = compileResult.Code;
+			m_package->BufferCode = compileResult.BufferCode;
+			m_packageCodeHash = HashCode(m_package->Code, m_package->BufferCode);
+			UpdateChangeState();
+
+			ShaderPackageCompiler::Apply(*m_package, compileResult.Shaders, compileResult.BufferShaders);
+			m_shaderCompiled = true;
+		}
+		else
+		{
+			ELYSIUM_WARN("Failed To Compile Shader: {0}", compileResult.Error);
+			m_shaderCompiled = false;
+		}
+
+		UpdateErrorMarkers(compileResult.Messages);
+	}
 }
 
 void ShaderEditorPanel::OnImGuiRender()
@@ -93,16 +170,35 @@ void ShaderEditorPanel::OnImGuiRender()
 	const float panelWidth = ImGui::GetWindowWidth();
 
 	ImGui::Columns(3, "Controls", false);
-	ImGui::SetColumnWidth(0, 275.f);
-	ImGui::SetColumnWidth(1, std::max(10.0f, panelWidth - 275.f - 200.f));
+	ImGui::SetColumnWidth(0, 320.f);
+	ImGui::SetColumnWidth(1, std::max(10.0f, panelWidth - 320.f - 200.f));
 	if (ImGui::Button(ICON_FA_PLAY_CIRCLE, ImVec2(40, 25)))
 	{
 		Compile();
 	}
 
+	ImGui::SameLine();
+	const bool liveCompile = m_liveCompile;
+	if (liveCompile)
+		ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(0.4f, 0.6f, 1.f, 1.f));
+	if (ImGui::Button(ICON_FA_BOLT, ImVec2(40, 25)))
+	{
+		m_liveCompile = !m_liveCompile;
+		m_liveCompilePending = m_liveCompile;
+	}
+	if (liveCompile)
+		ImGui::PopStyleColor();
+	if (ImGui::IsItemHovered())
+		ImGui::SetTooltip("Live Compile: Recompiles after a Short Pause in Typing.");
+
 	ImVec4 statusColor;
 	const char* statusIcon = "";
-	if (m_shaderCompiled)
+	if (m_backgroundCompiler->IsCompiling())
+	{
+		statusColor = ImVec4(0.4f, 0.6f, 1.f, 1.f);
+		statusIcon = ICON_FA_SYNC;
+	}
+	else if (m_shaderCompiled)
 	{
 		if (m_textChanged)
 		{
@@ -190,14 +286,26 @@ void ShaderEditorPanel::OnImGuiRender()
 		ImGui::BulletText("EXPOSURE [float]: the bloom pass exposure value.");
 
 		ImGui::BulletText("TIME [float]: shader time value.");
+		ImGui::BulletText("FRAME [int]: frames drawn since the buffers were last cleared.");
 
 		ImGui::BulletText("TEX# [texture]: slot sample texture ranging from 0-7 (e.g: TEX0...TEX7).");
+		ImGui::BulletText("BUFFER_# [texture]: buffer pass output ranging from A-D (e.g: BUFFER_A...BUFFER_D).");
+		ImGui::BulletText("BUFFER_# read by itself or a pass drawn before it gives its previous frame.");
 	}
 
 	ImGui::Separator();
 
+	DrawPassTabs();
+
 	// Shader Text Editor
-	m_textEditor->Render("TextEditor");
+	TextEditor& textEditor = *m_textEditors[m_activePass];
+	textEditor.Render("TextEditor");
+	if (textEditor.IsTextChanged())
+	{
+		++m_editVersion;
+		m_lastEditTime = std::chrono::steady_clock::now();
+		m_liveCompilePending = true;
+	}
 
 	ImGui::End();
 
@@ -220,6 +328,23 @@ void ShaderEditorPanel::OnImGuiRender()
 		if (ImGui::BeginMenuBar())
 		{
 			ImGui::TextUnformatted("Slots");
+
+			// Mips and compression are decided when an image loads, so changing them reloads the slots
+			ImageLoadOptions loadOptions = m_loadedImages.GetLoadOptions();
+			bool optionsChanged = false;
+			ImGui::Spacing();
+			ImGui::SameLine();
+			optionsChanged |= ImGui::Checkbox("Mipmaps", &loadOptions.GenerateMips);
+			ImGui::SameLine();
+			optionsChanged |= ImGui::Checkbox("Compress (BC3)", &loadOptions.Compress);
+			if (ImGui::IsItemHovered())
+				ImGui::SetTooltip("PNG and JPEG Images are Compressed on Load and Cached Next to the Source.\nDDS and KTX2 Images Keep their Stored Format.");
+			if (optionsChanged)
+			{
+				m_loadedImages.SetLoadOptions(loadOptions);
+				++m_package->Revision;
+			}
+
 			ImGui::EndMenuBar();
 		}
 		ImGui::Spacing();
@@ -231,15 +356,39 @@ void ShaderEditorPanel::OnImGuiRender()
 		ImVec4 unselectedColor(0.6f, 0.8f, 0.8f, 1.0f);
 		for (uint8_t i = 0; i < LoadedImages::MaxNumImages; ++i)
 		{
-			Elysium::Shared<Elysium::Texture2D> tex = m_loadedImages.m_textures[i];
+			const Elysium::Shared<SlotTexture>& tex = m_loadedImages.m_textures[i];
 			ImGui::Text("%i.", i);
 			ImGui::SameLine();
 
-			if (tex != nullptr)
+			const VideoStream* stream = m_loadedImages.GetStream(i);
+			const VideoStream::Statistics streamStatistics = stream != nullptr ? stream->GetStatistics() : VideoStream::Statistics();
+			if (m_loadedImages.IsLoading(i))
+			{
+				ImGui::TextDisabled("%s %s", ICON_FA_SPINNER, m_loadedImages.m_filenames[i].c_str());
+				if (ImGui::IsItemHovered())
+					ImGui::SetTooltip("%s", m_loadedImages.m_filepaths[i].c_str());
+			}
+			else if (stream != nullptr)
+			{
+				ImGui::Text("%s %s", ICON_FA_FILM, m_loadedImages.m_filenames[i].c_str());
+				if (ImGui::IsItemHovered())
+				{
+					// Some containers only reveal their length once playback has run off the end
+					const int64_t frameCount = stream->GetFrameCount();
+					const std::string frameCountStr = frameCount > 0 ? std::to_string(frameCount) : "?";
+					ImGui::SetTooltip("%s\n%ux%u at %.2f FPS, %s Frames\nShown: %llu, Decoded: %llu", m_loadedImages.m_filepaths[i].c_str(), tex->GetWidth(), tex->GetHeight(),
+									  stream->GetFrameRate(), frameCountStr.c_str(),
+									  static_cast<unsigned long long>(streamStatistics.FramesShown), static_cast<unsigned long long>(streamStatistics.FramesDecoded));
+				}
+			}
+			else if (tex != nullptr)
 			{
 				ImGui::Text(m_loadedImages.m_filenames[i].c_str());
 				if (ImGui::IsItemHovered())
-					ImGui::SetTooltip(tex->GetName().c_str());
+				{
+					ImGui::SetTooltip("%s\n%ux%u %s, %u Levels, %.2f MB", m_loadedImages.m_filepaths[i].c_str(), tex->GetWidth(), tex->GetHeight(),
+									  ImageData::GetFormatName(tex->GetFormat()), tex->GetLevelCount(), tex->GetByteSize() / (1024.0f * 1024.0f));
+				}
 			}
 			else
 			{
@@ -247,17 +396,43 @@ void ShaderEditorPanel::OnImGuiRender()
 			}
 
 			ImGui::NextColumn();
+			if (stream != nullptr && tex != nullptr)
+			{
+				ImGui::TextDisabled("Dropped: %llu", static_cast<unsigned long long>(streamStatistics.DroppedFrames));
+				ImGui::SameLine();
+				ImGui::TextDisabled("Decode: %.1f ms", streamStatistics.AverageDecodeMs);
+				if (ImGui::IsItemHovered())
+					ImGui::SetTooltip("Average Time to Decode and Convert a Frame on the Worker Thread (Last: %.1f ms)", streamStatistics.LastDecodeMs);
+			}
 			ImGui::NextColumn();
 			if (ImGui::Button(ICON_FA_PLUS, ImVec2(40, 25)))
 			{
 				if (m_loadedImages.TryAddToSlot(i))
-					m_package->Textures[i] = m_loadedImages.m_textures[i]->GetName();
+				{
+					m_package->Textures[i] = m_loadedImages.m_filepaths[i];
+					++m_package->Revision;
+				}
+			}
+			if (ImGui::IsItemHovered())
+				ImGui::SetTooltip("Right Click to Add an Image Sequence");
+			if (ImGui::BeginPopupContextItem("##SlotAddMenu"))
+			{
+				if (ImGui::MenuItem("Add Image Sequence..."))
+				{
+					if (m_loadedImages.TryAddSequenceToSlot(i))
+					{
+						m_package->Textures[i] = m_loadedImages.m_filepaths[i];
+						++m_package->Revision;
+					}
+				}
+				ImGui::EndPopup();
 			}
 			ImGui::SameLine();
 			if (ImGui::Button(ICON_FA_TRASH, ImVec2(40, 25)))
 			{
 				m_loadedImages.RemoveSlot(i);
 				m_package->Textures[i] = "";
+				++m_package->Revision;
 			}
 
 			ImGui::NextColumn();
@@ -274,21 +449,20 @@ void ShaderEditorPanel::OnImGuiRender()
 	ImGui::PopStyleVar();
 }
 
-void ShaderEditorPanel::GetCurrentShader(Elysium::Shared<Elysium::Shader>& output)
+void ShaderEditorPanel::GetCurrentShaders(ShaderVariants& output)
 {
-	// Bind the loaded images to the correct slots
-	m_package->Shader->Bind();
+	// Bind the loaded images to the correct slots, the cache skips units that already hold them
 	for (uint8_t i = 0; i < LoadedImages::MaxNumImages; ++i)
 	{
-		Elysium::Shared<Elysium::Texture2D> tex = m_loadedImages.m_textures[i];
+		const Elysium::Shared<SlotTexture>& tex = m_loadedImages.m_textures[i];
+		const uint32_t unit = ShaderPackage::FirstTextureUnit + i;
 		if (tex != nullptr)
-			tex->Bind(i);
+			RenderStateCache::BindTexture(unit, tex);
 		else
-			Elysium::GlobalRendererBase::GetDefaultTexture()->Bind(i);
+			RenderStateCache::BindTexture(unit, Elysium::GlobalRendererBase::GetDefaultTexture());
 	}
-	m_package->Shader->Unbind();
 
-	output = m_package->Shader;
+	output = m_package->Shaders;
 }
 
 void ShaderEditorPanel::NewFile()
@@ -307,8 +481,6 @@ void ShaderEditorPanel::NewFile()
 
 	m_package->Reset();
 
-	m_textFileChanged = true;
-
 	ResetShader();
 }
 
@@ -328,7 +500,9 @@ void ShaderEditorPanel::SaveFile()
 
 void ShaderEditorPanel::Compile()
 {
-	m_package->Code = m_textEditor->GetText();
+	SyncEditorText();
+	UpdateChangeState();
+
 	m_shaderCompileRequested = true;
 }
 
@@ -346,13 +520,17 @@ void ShaderEditorPanel::LoadFromFile()
 		{
 			for (uint8_t i = 0; i < LoadedImages::MaxNumImages; ++i)
 				m_loadedImages.ForceAddToSlot(i, m_package->Textures[i]);
+
+			++m_package->Revision;
 		}
 
 		m_currentFileName = Elysium::FileUtils::GetFileName(m_currentFile);
 
-		m_textEditor->SetText(m_package->Code);
-		m_savedShaderCode = m_textEditor->GetText();
-		m_textFileChanged = false;
+		SetEditorText(m_package->Code, m_package->BufferCode);
+		SyncEditorText();
+		m_savedCodeHash = m_currentCodeHash;
+		UpdateChangeState();
+
 		m_shaderCompileRequested = true;
 	}
 }
@@ -374,24 +552,24 @@ void ShaderEditorPanel::SaveCurrentCode()
 	if (m_currentFile.empty())
 		return;
 
-	m_package->Code = m_textEditor->GetText();
+	SyncEditorText();
 
 	ShaderPackageSerializer::Serialize(m_currentFile, *m_package);
 
-	m_savedShaderCode = m_package->Code;
-	m_textFileChanged = false;
+	m_savedCodeHash = m_currentCodeHash;
+	UpdateChangeState();
 
 #if 0
 	std::ofstream outfileStream(m_currentFile);
 	if (outfileStream.is_open())
 	{
-		m_package->Code = m_textEditor->GetText();
+		m_package->Code = m_textEditors[ImagePass]->GetText();
 
 		outfileStream << m_package->Code;
 		outfileStream.close();
 
-		m_savedShaderCode = m_package->Code;
-		m_textFileChanged = false;
+		m_savedCodeHash = HashCode(m_package->Code, m_package->BufferCode);
+		UpdateChangeState();
 	}
 	else
 	{
@@ -403,80 +581,398 @@ void ShaderEditorPanel::SaveCurrentCode()
 void ShaderEditorPanel::ResetShader()
 {
 	m_package->Code = m_defaultPixelShaderCode;
+	m_package->BufferCode = {};
 
 	m_currentFileName = "Untitled";
-	m_textEditor->SetText(m_package->Code);
-	m_package->Code = m_textEditor->GetText();
-	CompileShader();
+	SetEditorText(m_package->Code, m_package->BufferCode);
+	SyncEditorText();
+	m_savedCodeHash = m_currentCodeHash;
+	UpdateChangeState();
 
-	m_textChanged = false;
-	m_textFileChanged = false;
+	CompileShader();
 }
 
 void ShaderEditorPanel::CompileShader()
 {
-	std::stringstream shaderCode;
-	shaderCode << m_baseShaderCode;
-	shaderCode << m_package->Code;
+	// The result is picked up in OnUpdate once the worker has finished
+	m_backgroundCompiler->Request(m_package->Code, m_package->BufferCode, false);
+}
 
-	// Compile this shader code
-	std::string compileError;
-	Elysium::Shared<Elysium::Shader> newShader = Elysium::ShaderFactory::CreateFromCode(shaderCode.str(), &compileError);
-	if (newShader == nullptr)
+void ShaderEditorPanel::ReadEditorText(std::string& code, BufferPassCodes& bufferCode) const
+{
+	code = m_textEditors[ImagePass]->GetText();
+	for (uint8_t pass = 0; pass < ShaderPackage::MaxBufferPasses; ++pass)
 	{
-		ELYSIUM_WARN("Failed To Compile Shader: {0}", compileError);
-		m_shaderCompiled = false;
+		bufferCode[pass] = m_textEditors[pass]->GetText();
+		if (bufferCode[pass].find_first_not_of(" \t\r\n") == std::string::npos)
+			bufferCode[pass].clear();
 	}
-	else
+}
+
+void ShaderEditorPanel::SetEditorText(const std::string& code, const BufferPassCodes& bufferCode)
+{
+	m_textEditors[ImagePass]->SetText(code);
+	for (uint8_t pass = 0; pass < ShaderPackage::MaxBufferPasses; ++pass)
+		m_textEditors[pass]->SetText(bufferCode[pass]);
+}
+
+void ShaderEditorPanel::DrawPassTabs()
+{
+	if (!ImGui::BeginTabBar("Passes"))
+		return;
+
+	// Image first, it is the pass every package has
+	for (uint8_t tab = 0; tab <= ShaderPackage::MaxBufferPasses; ++tab)
+	{
+		const uint8_t pass = tab == 0 ? ImagePass : tab - 1;
+
+		const bool hasErrors = m_passHasErrors[pass];
+		if (hasErrors)
+			ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(1.f, 0.2f, 0.2f, 1.f));
+		const bool selected = ImGui::BeginTabItem(PassGraph::GetBufferName(pass));
+		if (hasErrors)
+			ImGui::PopStyleColor();
+
+		if (pass != ImagePass && ImGui::IsItemHovered())
+		{
+			if (!m_package->BufferCode[pass].empty() && !m_package->Schedule.IsScheduled(pass))
+				ImGui::SetTooltip("Skipped: Nothing the Image Reads Samples %s.", PassGraph::GetBufferDefine(pass));
+			else if (m_package->Schedule.Feedback[pass])
+				ImGui::SetTooltip("Feedback: Reads of %s Before It Is Drawn See the Previous Frame.", PassGraph::GetBufferDefine(pass));
+		}
+
+		if (selected)
+		{
+			m_activePass = pass;
+			ImGui::EndTabItem();
+		}
+	}
+
+	ImGui::EndTabBar();
+}
+
+void ShaderEditorPanel::SyncEditorText()
+{
+	// The editor normalizes line endings, so the package keeps the text exactly as the editor holds it
+	ReadEditorText(m_package->Code, m_package->BufferCode);
+	m_currentCodeHash = HashCode(m_package->Code, m_package->BufferCode);
+	m_packageCodeHash = m_currentCodeHash;
+	m_trackedEditVersion = m_editVersion;
+}
+
+void ShaderEditorPanel::UpdateChangeState()
+{
+	m_textChanged = m_currentCodeHash != m_packageCodeHash;
+	m_textFileChanged = m_currentCodeHash != m_savedCodeHash;
+}
+
+void ShaderEditorPanel::UpdateWatchedFiles()
+{
+	// Sequence patterns don't name a single file to watch
+	const auto isWatchable = [](const std::string& filepath) { return !filepath.empty() && filepath.find('%') == std::string::npos; };
+
+	bool watchedChanged = m_watchedFiles.empty() || m_watchedFiles[0] != m_currentFile;
+	for (uint8_t i = 0; i < LoadedImages::MaxNumImages && !watchedChanged; ++i)
+	{
+		const std::string& filepath = m_loadedImages.m_filepaths[i];
+		watchedChanged = m_watchedFiles[i + 1] != (isWatchable(filepath) ? filepath : "");
+	}
+	if (!watchedChanged)
+		return;
+
+	m_watchedFiles.assign(1, m_currentFile);
+	for (uint8_t i = 0; i < LoadedImages::MaxNumImages; ++i)
+	{
+		const std::string& filepath = m_loadedImages.m_filepaths[i];
+		m_watchedFiles.push_back(isWatchable(filepath) ? filepath : "");
+	}
+	m_fileWatcher->SetFiles(m_watchedFiles);
+}
+
+void ShaderEditorPanel::ApplyExternalChanges(const std::vector<std::string>& changedFiles)
+{
+	for (const std::string& filepath : changedFiles)
+	{
+		if (filepath == m_currentFile)
+		{
+			ReloadPackageFile();
+			continue;
+		}
+
+		for (uint8_t i = 0; i < LoadedImages::MaxNumImages; ++i)
+		{
+			if (m_loadedImages.m_filepaths[i] == filepath)
+				m_loadedImages.ReloadSlot(i);
+		}
+	}
+}
+
+void ShaderEditorPanel::ReloadPackageFile()
+{
+	// Removed or mid rename, the write that puts it back is reported again
+	if (!Elysium::FileUtils::FileExists(m_currentFile))
+		return;
+
+	// Likewise a half written file fails to parse, the write completing it is reported again
+	ShaderPackage diskPackage;
+	try
+	{
+		if (!ShaderPackageSerializer::Deserialize(diskPackage, m_currentFile))
+			return;
+	}
+	catch (const YAML::Exception&)
+	{
+		return;
+	}
+
+	bool settingsChanged = m_package->Dimensions != diskPackage.Dimensions || m_package->Gamma != diskPackage.Gamma ||
+		m_package->Exposure != diskPackage.Exposure || m_package->BloomEnabled != diskPackage.BloomEnabled || m_package->BloomMode != diskPackage.BloomMode;
+	m_package->Dimensions = diskPackage.Dimensions;
+	m_package->Gamma = diskPackage.Gamma;
+	m_package->Exposure = diskPackage.Exposure;
+	m_package->BloomEnabled = diskPackage.BloomEnabled;
+	m_package->BloomMode = diskPackage.BloomMode;
+
+	for (uint8_t i = 0; i < LoadedImages::MaxNumImages; ++i)
+	{
+		if (m_package->Textures[i] == diskPackage.Textures[i])
+			continue;
+
+		m_package->Textures[i] = diskPackage.Textures[i];
+		m_loadedImages.ForceAddToSlot(i, m_package->Textures[i]);
+		settingsChanged = true;
+	}
+
+	if (settingsChanged)
+		++m_package->Revision;
+
+	const size_t diskCodeHash = HashCode(diskPackage.Code, diskPackage.BufferCode);
+	if (diskCodeHash == m_savedCodeHash)
+		return;
+
+	if (m_textFileChanged)
 	{
-		m_package->Shader = newShader;
-		m_shaderCompiled = true;
+		Elysium::FileDialogs::DialogResult result = Elysium::FileDialogs::YesNoMessage("Shader Changed on Disk, Discard Unsaved Changes?", m_currentFileName.c_str());
+		if (result != Elysium::FileDialogs::DialogResult::Yes)
+		{
+			// The editor keeps its text, which now differs from the file on disk
+			m_savedCodeHash = diskCodeHash;
+			UpdateChangeState();
+			return;
+		}
+	}
 
-		// Rebind texture slots
-		int samplers[LoadedImages::MaxNumImages];
-		for (int i = 0; i < LoadedImages::MaxNumImages; ++i)
-			samplers[i] = i;
+	SetEditorText(diskPackage.Code, diskPackage.BufferCode);
+	SyncEditorText();
+	m_savedCodeHash = m_currentCodeHash;
+	UpdateChangeState();
 
-		m_package->Shader->Bind();
-		m_package->Shader->SetIntArray("textureMaps", samplers, LoadedImages::MaxNumImages);
-		m_package->Shader->Unbind();
+	// Straight to the compiler, saving here would write the file that was just changed
+	CompileShader();
+}
+
+void ShaderEditorPanel::UpdateErrorMarkers(const std::vector<ShaderCompileMessage>& messages)
+{
+	// Messages pointing into the base shader have no line to sit on, the log already has them
+	std::array<TextEditor::ErrorMarkers, ShaderPackage::MaxBufferPasses + 1> markers;
+	m_passHasErrors = {};
+	for (const ShaderCompileMessage& message : messages)
+	{
+		const uint8_t pass = std::min(message.Pass, ImagePass);
+		m_passHasErrors[pass] = true;
+		if (message.Line <= 0)
+			continue;
+
+		std::string& marker = markers[pass][message.Line];
+		if (!marker.empty())
+			marker += "\n";
+		marker += message.Text;
 	}
+
+	for (uint8_t pass = 0; pass <= ImagePass; ++pass)
+		m_textEditors[pass]->SetErrorMarkers(markers[pass]);
 }
 
 void ShaderEditorPanel::LoadedImages::ForceAddToSlot(uint8_t slot, const std::string& filepath)
 {
-	if (Elysium::FileUtils::FileExists(filepath))
+	// Sequence patterns don't name an actual file, the stream reports them as failed instead
+	const bool isStream = VideoStream::IsStreamPath(filepath);
+	if (filepath.empty() || (!isStream && !Elysium::FileUtils::FileExists(filepath)))
 	{
-		m_filenames[slot] = Elysium::FileUtils::GetFileName(filepath, true);
-		m_textures[slot] = Elysium::Texture2D::Create(filepath);
+		RemoveSlot(slot);
+		return;
+	}
+
+	m_filenames[slot] = Elysium::FileUtils::GetFileName(filepath, true);
+	m_filepaths[slot] = filepath;
+	m_textures[slot] = nullptr;
+
+	if (isStream)
+	{
+		m_pendingRequests[slot] = 0;
+		m_streams[slot] = Elysium::CreateUnique<VideoStream>(filepath);
+	}
+	else
+	{
+		m_streams[slot] = nullptr;
+		m_pendingRequests[slot] = m_loader->Request(filepath);
 	}
 }
 
 bool ShaderEditorPanel::LoadedImages::TryAddToSlot(uint8_t slot)
 {
-	const std::string textureFilepath = Elysium::FileDialogs::OpenFile("All Supported Formats (*.png, *.jpg, *.jpeg)\0*.png;*.jpg;*.jpeg\0"
+	const std::string textureFilepath = Elysium::FileDialogs::OpenFile("All Supported Formats (*.png, *.jpg, *.jpeg, *.dds, *.ktx2, *.mp4, *.mov, *.avi, *.mkv, *.webm)\0*.png;*.jpg;*.jpeg;*.dds;*.ktx2;*.mp4;*.mov;*.avi;*.mkv;*.webm\0"
 																	   "PNG Image (*.png)\0*.png\0"
-																	   "JPEG Image (*.jpg, *.jpeg, *.jpe)\0*.jpg;*.jpeg;*.jpe\0");
+																	   "JPEG Image (*.jpg, *.jpeg, *.jpe)\0*.jpg;*.jpeg;*.jpe\0"
+																	   "Compressed Texture (*.dds, *.ktx2)\0*.dds;*.ktx2\0"
+																	   "Video (*.mp4, *.mov, *.avi, *.mkv, *.webm)\0*.mp4;*.mov;*.avi;*.mkv;*.webm\0");
 	if (Elysium::FileUtils::FileExists(textureFilepath))
 	{
-		m_filenames[slot] = Elysium::FileUtils::GetFileName(textureFilepath, true);
-		m_textures[slot] = Elysium::Texture2D::Create(textureFilepath);
+		ForceAddToSlot(slot, textureFilepath);
 		return true;
 	}
 	return false;
 }
 
+bool ShaderEditorPanel::LoadedImages::TryAddSequenceToSlot(uint8_t slot)
+{
+	const std::string frameFilepath = Elysium::FileDialogs::OpenFile("Image Sequence Frame (*.png, *.jpg, *.jpeg, *.tif, *.tiff, *.exr)\0*.png;*.jpg;*.jpeg;*.tif;*.tiff;*.exr\0");
+	if (!Elysium::FileUtils::FileExists(frameFilepath))
+		return false;
+
+	const std::string pattern = VideoStream::MakeSequencePattern(frameFilepath);
+	if (pattern.empty())
+	{
+		ELYSIUM_WARN("Image Sequence Frames Need a Frame Number in Their Name: {0}", frameFilepath);
+		return false;
+	}
+
+	ForceAddToSlot(slot, pattern);
+	return true;
+}
+
 void ShaderEditorPanel::LoadedImages::RemoveSlot(uint8_t slot)
 {
 	m_textures[slot] = nullptr;
 	m_filenames[slot] = "";
+	m_filepaths[slot] = "";
+	m_pendingRequests[slot] = 0;
+	m_streams[slot] = nullptr;
+
+	TextureCache::Trim();
+}
+
+void ShaderEditorPanel::LoadedImages::ReloadSlot(uint8_t slot)
+{
+	const std::string& filepath = m_filepaths[slot];
+
+	// Removed or mid rename, the write that puts it back is reported again
+	if (filepath.empty() || !Elysium::FileUtils::FileExists(filepath))
+		return;
+
+	// Streams start over from the new file
+	if (m_streams[slot] != nullptr)
+	{
+		ForceAddToSlot(slot, filepath);
+		return;
+	}
+
+	// The texture cache keys on modification time, so this decodes the new contents
+	m_pendingRequests[slot] = m_loader->Request(filepath);
+}
+
+bool ShaderEditorPanel::LoadedImages::IsLoading(uint8_t slot) const
+{
+	if (m_streams[slot] != nullptr)
+		return m_textures[slot] == nullptr;
+	return m_pendingRequests[slot] != 0;
+}
+
+void ShaderEditorPanel::LoadedImages::SetLoadOptions(const ImageLoadOptions& options)
+{
+	m_loader->SetOptions(options);
+
+	// Streamed frames are always uploaded as they are
+	for (uint8_t i = 0; i < MaxNumImages; ++i)
+	{
+		if (!m_filepaths[i].empty() && m_streams[i] == nullptr)
+			ForceAddToSlot(i, m_filepaths[i]);
+	}
+}
+
+const ImageLoadOptions& ShaderEditorPanel::LoadedImages::GetLoadOptions() const
+{
+	return m_loader->GetOptions();
+}
+
+bool ShaderEditorPanel::LoadedImages::Update(float time, bool& streamFrameChanged)
+{
+	std::vector<AsyncTextureLoader::Result> results;
+	m_loader->Update(results);
+
+	bool changed = false;
+	for (AsyncTextureLoader::Result& result : results)
+	{
+		// Slots that were cleared or reassigned in the meantime no longer want this image
+		for (uint8_t i = 0; i < MaxNumImages; ++i)
+		{
+			if (m_pendingRequests[i] != result.RequestId)
+				continue;
+
+			m_pendingRequests[i] = 0;
+			if (result.Texture != nullptr)
+				m_textures[i] = std::move(result.Texture);
+			else
+				RemoveSlot(i);
+
+			changed = true;
+			break;
+		}
+	}
+
+	for (uint8_t i = 0; i < MaxNumImages; ++i)
+	{
+		if (m_streams[i] == nullptr)
+			continue;
+
+		if (m_streams[i]->HasFailed())
+		{
+			ELYSIUM_WARN("Removed Unreadable Stream from Slot {0}: {1}", i, m_filepaths[i]);
+			RemoveSlot(i);
+			changed = true;
+		}
+		else if (m_streams[i]->Update(time))
+		{
+			// The texture is written in place, so only the first frame changes what the slot binds
+			if (m_textures[i] == nullptr)
+			{
+				m_textures[i] = m_streams[i]->GetTexture();
+				changed = true;
+			}
+			else
+				streamFrameChanged = true;
+		}
+	}
+
+	// Images dropped from their slots may have brought the cache back over budget
+	if (changed)
+		TextureCache::Trim();
+	return changed;
 }
 
 ShaderEditorPanel::LoadedImages::LoadedImages()
 {
+	m_loader = Elysium::CreateUnique<AsyncTextureLoader>();
+
 	for (uint8_t i = 0; i < LoadedImages::MaxNumImages; ++i)
 	{
 		m_textures[i] = nullptr;
 		m_filenames[i] = "";
+		m_filepaths[i] = "";
+		m_pendingRequests[i] = 0;
 	}
 }
+
+ShaderEditorPanel::LoadedImages::~LoadedImages()
+{
+}
\ No newline at end of file
@@ -2,19 +2,35 @@
 
 #include "Elysium.h"
 
+#include "ShaderPackage.h"
+#include "ShaderPackageCompiler.h"
+
 class TextEditor;
-struct ShaderPackage;
+class BackgroundShaderCompiler;
+class FileWatcher;
+class AsyncTextureLoader;
+class SlotTexture;
+class VideoStream;
+struct ImageLoadOptions;
 
 class ShaderEditorPanel
 {
+public:
+	// Pause in typing after which live mode sends the code off to compile
+	static constexpr std::chrono::milliseconds LiveCompileDelay = std::chrono::milliseconds(350);
+	// Editor index of the image pass, the buffer passes come before it
+	static constexpr uint8_t ImagePass = ShaderPackage::MaxBufferPasses;
 public:
 	ShaderEditorPanel(ShaderPackage* package);
 	~ShaderEditorPanel();
 public:
 	void OnUpdate();
 	void OnImGuiRender();
+
+	// Video and image sequence slots show the frame due at this time
+	inline void SetPlaybackTime(float time) { m_playbackTime = time; }
 public:
-	void GetCurrentShader(Elysium::Shared<Elysium::Shader>& output);
+	void GetCurrentShaders(ShaderVariants& output);
 
 	void NewFile();
 	void OpenFile();
@@ -27,40 +43,96 @@ private:
 	
 	void ResetShader();
 	void CompileShader();
+	void UpdateErrorMarkers(const std::vector<ShaderCompileMessage>& messages);
+
+	// Reads every pass out of the editors, buffers holding only whitespace count as empty
+	void ReadEditorText(std::string& code, BufferPassCodes& bufferCode) const;
+	void SetEditorText(const std::string& code, const BufferPassCodes& bufferCode);
+	void DrawPassTabs();
+
+	// Re-reads the editor text after a SetText, edits made through the editor are picked up by OnUpdate
+	void SyncEditorText();
+	void UpdateChangeState();
+
+	// Follows the package file and slot images as they get opened, added and removed
+	void UpdateWatchedFiles();
+	void ApplyExternalChanges(const std::vector<std::string>& changedFiles);
+	// Takes over only what differs from the open package, our own saves change nothing
+	void ReloadPackageFile();
 private:
 	ShaderPackage* m_package;
 
-	std::string m_baseShaderCode;
+	ShaderPackageCompiler m_compiler;
+	Elysium::Unique<BackgroundShaderCompiler> m_backgroundCompiler;
 	std::string m_defaultPixelShaderCode;
 
 
-	std::string m_savedShaderCode;
+	// Hashes of the editor, compiled and saved code of all passes, so the documents are only read back after an edit
+	uint64_t m_editVersion;
+	uint64_t m_trackedEditVersion;
+	size_t m_currentCodeHash;
+	size_t m_packageCodeHash;
+	size_t m_savedCodeHash;
+
 	bool m_shaderCompileRequested;
 	bool m_shaderCompiled;
 
 	bool m_textChanged;
 	bool m_textFileChanged;
 
+	bool m_liveCompile;
+	bool m_liveCompilePending;
+	std::chrono::steady_clock::time_point m_lastEditTime;
+
 	std::string m_currentFile;
 	std::string m_currentFileName;
 
-	Elysium::Unique<TextEditor> m_textEditor;
+	// One editor per pass, each keeps its own cursor, undo history and error markers
+	std::array<Elysium::Unique<TextEditor>, ShaderPackage::MaxBufferPasses + 1> m_textEditors;
+	std::array<bool, ShaderPackage::MaxBufferPasses + 1> m_passHasErrors;
+	uint8_t m_activePass;
+
+	Elysium::Unique<FileWatcher> m_fileWatcher;
+	std::vector<std::string> m_watchedFiles;
 
 	bool m_imageEditorVisible;
+	float m_playbackTime;
 
 	struct LoadedImages
 	{
 	public:
-		static constexpr uint8_t MaxNumImages = 8;
+		static constexpr uint8_t MaxNumImages = ShaderPackage::MaxTextureSlots;
 	public:
 		LoadedImages();
+		~LoadedImages();
 	public:
+		// Slots keep the default texture bound until their image has finished loading
 		void ForceAddToSlot(uint8_t slot, const std::string& filepath);
 		bool TryAddToSlot(uint8_t slot);
+		// Picks one frame of a numbered image sequence and streams all of them
+		bool TryAddSequenceToSlot(uint8_t slot);
 		void RemoveSlot(uint8_t slot);
+		// Loads the slot's file again after it changed on disk, the current image stays bound until then
+		void ReloadSlot(uint8_t slot);
+
+		// Swaps in finished images and the streamed frames due at the given time, returns whether any slot
+		// changed what it binds. Streams writing a new frame into their texture set streamFrameChanged.
+		bool Update(float time, bool& streamFrameChanged);
+
+		bool IsLoading(uint8_t slot) const;
+		inline const VideoStream* GetStream(uint8_t slot) const { return m_streams[slot].get(); }
+
+		// Reloads every filled slot with the new options
+		void SetLoadOptions(const ImageLoadOptions& options);
+		const ImageLoadOptions& GetLoadOptions() const;
 	public:
-		std::array<Elysium::Shared<Elysium::Texture2D>, 8> m_textures;
+		std::array<Elysium::Shared<SlotTexture>, 8> m_textures;
 		std::array<std::string, 8> m_filenames;
+		std::array<std::string, 8> m_filepaths;
+	private:
+		Elysium::Unique<AsyncTextureLoader> m_loader;
+		std::array<uint64_t, 8> m_pendingRequests;
+		std::array<Elysium::Unique<VideoStream>, 8> m_streams;
 	};
 	LoadedImages m_loadedImages;
 };
\ No newline at end of file
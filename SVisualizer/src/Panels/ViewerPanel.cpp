@@ -2,87 +2,67 @@
 #include "ViewerPanel.h"
 
 #include "Elysium.h"
-#include "Elysium/Factories/ShaderFactory.h"
 
 #include "ShaderPackage.h"
+#include "Profiling/FrameProfiler.h"
+#include "Rendering/RenderStateCache.h"
+#include "Textures/VideoStream.h"
+
+#include "Elysium/Utils/FileUtils.h"
 
 #include <imgui.h>
 #include <imgui_internal.h>
 
-#include <opencv2/opencv.hpp>
+#include <filesystem>
 
 ViewerPanel::ViewerPanel(ShaderPackage* package)
 	: m_package(package), 
 	m_size(1, 1),
+	m_requestedSize(1, 1),
+	m_resizeRequestTime(0.0f),
 	m_outputSize(1, 1),
-	m_outputSizeChanged(false),
-	m_orthoSize(500.f),
-	m_zoomModifier(10.f),
+	m_zoom(1.f),
+	m_zoomModifier(1.1f),
+	m_panOffset(0, 0),
 	m_focused(false),
 	m_hovered(false),
 	m_currentTime(0),
+	m_prevTotalTime(Elysium::Time::TotalTime()),
 	m_prevGamma(0),
 	m_prevExposure(0),
+	m_renderOnDemand(true),
+	m_idleFrameRate(10),
+	m_outputDirty(true),
+	m_renderedTime(0),
+	m_renderedRevision(0),
+	m_renderedStreamRevision(0),
+	m_renderedShader(nullptr),
+	m_prevBloomEnabled(false),
+	m_prevBloomMode(BloomFilterMode::Count),
+	m_progressiveEnabled(false),
+	m_tileSize(256),
+	m_tileBudgetMs(8.0f),
+	m_previewMode(PreviewMode::Full),
+	m_renderScale(1.0f),
+	m_appliedRenderScale(0.0f),
+	m_targetRenderMs(12.0f),
+	m_lastRenderMs(0.0f),
+	m_lastScaleChangeTime(0.0f),
+	m_hdrExportBright(false),
+	m_hdrExportBloom(false),
 	m_playing(true),
 	m_settingsVisible(false),
-	m_debugPass(DrawPass::None)
+	m_debugPass(DrawPass::None),
+	m_prevDebugPass(DrawPass::None)
 {
-	Elysium::FrameBufferSpecification bufferspecs;
-	bufferspecs.Attachments = { Elysium::FrameBufferTextureFormat::RGBA8 };
-	bufferspecs.Width = m_package->Dimensions.x;
-	bufferspecs.Height = m_package->Dimensions.y;
-	bufferspecs.SwapChainTarget = false;
-
-	m_fbo = Elysium::FrameBuffer::Create(bufferspecs);
-	m_shaderfbo = Elysium::FrameBuffer::Create(bufferspecs);
-
-	Elysium::FrameBufferSpecification hdrbufferspecs;
-	hdrbufferspecs.Attachments = { 
-		Elysium::FrameBufferTextureFormat::RGBA16F,
-		Elysium::FrameBufferTextureFormat::RGBA16F 
-	};
-	hdrbufferspecs.Width = m_package->Dimensions.x;
-	hdrbufferspecs.Height = m_package->Dimensions.y;
-	hdrbufferspecs.SwapChainTarget = false;
-	m_hdrfbo = Elysium::FrameBuffer::Create(hdrbufferspecs);
-
-	Elysium::FrameBufferSpecification bloombufferspecs = hdrbufferspecs;
-	bloombufferspecs.Attachments = {
-		Elysium::FrameBufferTextureFormat::RGBA16F
-	};
-	m_bloomFbos[0] = Elysium::FrameBuffer::Create(bloombufferspecs);
-	m_bloomFbos[1] = Elysium::FrameBuffer::Create(bloombufferspecs);
-
-	m_camera = Elysium::CreateShared<Elysium::OrthographicCamera>();
-
-	m_scene = Elysium::CreateShared<Elysium::Scene>();
-
-	m_sprite = m_scene->CreateEntity("Sprite_01");
-	auto& rectComp = m_sprite.AddComponent<Elysium::RectTransformComponent>();
-	auto& spriteComp = m_sprite.AddComponent<Elysium::SpriteComponent>();
+	m_renderer = Elysium::CreateUnique<PackageRenderer>();
+	m_renderer->SetCapacityStep(TargetCapacityStep);
 
-	spriteComp.Texture = Elysium::Texture2D::Create(m_shaderfbo->GetColorAttachementRendererID(), 0u, 0u);
-
-	m_spriteShader = Elysium::ShaderFactory::Create("Content/Engine/shaders/default_sprite.shader");
-	m_blurShader = Elysium::ShaderFactory::Create("Content/shaders/blur.shader");
-	m_bloomShader = Elysium::ShaderFactory::Create("Content/shaders/bloom.shader");
-	m_debugShader = Elysium::ShaderFactory::Create("Content/shaders/debug.shader");
-
-	int samplers[Elysium::RendererCaps::MaxTextureSlots];
-	for (int i = 0; i < Elysium::RendererCaps::MaxTextureSlots; ++i)
-		samplers[i] = i;
-
-	m_spriteShader->Bind();
-	m_spriteShader->SetIntArray("textureMaps", samplers, Elysium::RendererCaps::MaxTextureSlots);
-	m_spriteShader->Unbind();
-
-	ELYSIUM_CORE_ASSERT(m_spriteShader->IsCompiled(), "Sprite Shader Failed to Compile.");
-	ELYSIUM_CORE_ASSERT(m_blurShader->IsCompiled(), "Blur Shader Failed to Compile.");
-	ELYSIUM_CORE_ASSERT(m_bloomShader->IsCompiled(), "Bloom Shader Failed to Compile.");
-	ELYSIUM_CORE_ASSERT(m_debugShader->IsCompiled(), "Debug Shader Failed to Compile.");
+	UpdateViewport();
+}
 
-	UpdateCameraView();
-	UpdateCameraProjection();
+ViewerPanel::~ViewerPanel()
+{
 }
 
 void ViewerPanel::OnUpdate()
@@ -92,113 +72,149 @@ void ViewerPanel::OnUpdate()
 		Elysium::PostProcessData& postProcessRef = Elysium::CoreUniformBuffers::GetPostProcessDataRef();
 		m_prevGamma = postProcessRef.m_gammaAdjustment[0] = m_package->Gamma;
 		m_prevExposure = postProcessRef.m_exposure = m_package->Exposure;
+
+		m_outputDirty = true;
 	}
 
-	if (m_size != m_package->Dimensions)
+	if (m_prevBloomEnabled != m_package->BloomEnabled || m_prevBloomMode != m_package->BloomMode)
 	{
-		m_size = m_package->Dimensions;
+		m_prevBloomEnabled = m_package->BloomEnabled;
+		m_prevBloomMode = m_package->BloomMode;
 
-		const uint32_t sizeX = m_size.x;
-		const uint32_t sizeY = m_size.y;
+		m_renderer->SetBloom(m_package->BloomEnabled, m_package->BloomMode);
 
-		m_shaderfbo->Resize(sizeX, sizeY);
-		m_hdrfbo->Resize(sizeX, sizeY);
-		m_bloomFbos[0]->Resize(sizeX, sizeY);
-		m_bloomFbos[1]->Resize(sizeX, sizeY);
+		m_outputDirty = true;
+	}
 
-		auto& rectComp = m_sprite.GetComponent<Elysium::RectTransformComponent>();
-		const Elysium::Math::Vec2 dim((float)sizeX, (float)sizeY);
-		const Elysium::Math::Vec2 offset(sizeX * 0.5f, sizeY * 0.5f);
-		rectComp.SetTranslation(-offset);
-		rectComp.SetDimensions(dim);
+	if (m_prevDebugPass != m_debugPass)
+	{
+		m_prevDebugPass = m_debugPass;
 
-		FocusCamera();
-		UpdateCameraProjection();
+		m_outputDirty = true;
 	}
 
-	if (m_outputSizeChanged)
+	if (m_renderedRevision != m_package->Revision)
 	{
-		uint32_t clampSizeX = std::max(1, m_outputSize.x);
-		uint32_t clampSizeY = std::max(1, m_outputSize.y);
-		m_fbo->Resize(clampSizeX, clampSizeY);
+		m_renderedRevision = m_package->Revision;
+
+		m_outputDirty = true;
+	}
 
-		m_outputSizeChanged = false;
+	if (m_previewMode == PreviewMode::Adaptive)
+		UpdateAdaptiveScale();
 
-		FocusCamera();
-		UpdateCameraProjection();
+	// Every keystroke in the dimension fields changes the package, only the settled size is applied.
+	// The first size is taken right away so the package doesn't open on an empty frame.
+	if (m_requestedSize != m_package->Dimensions)
+	{
+		m_requestedSize = m_package->Dimensions;
+		m_resizeRequestTime = Elysium::Time::TotalTime();
 	}
-	
-	if (m_playing)
+	const bool firstResize = m_appliedRenderScale == 0.0f;
+	const bool dimensionsChanged = m_size != m_requestedSize && (firstResize || Elysium::Time::TotalTime() - m_resizeRequestTime >= ResizeSettleDelay);
+
+	if (dimensionsChanged || m_appliedRenderScale != m_renderScale)
 	{
-		m_scene->Computations();
-		m_currentTime = Elysium::Time::TotalTime();
+		if (dimensionsChanged)
+			m_size = m_requestedSize;
+		m_appliedRenderScale = m_renderScale;
+
+		// The shader still sees the full package dimensions through RESOLUTION and PIXCOORD
+		const uint32_t renderSizeX = std::max(1, static_cast<int>(m_size.x * m_renderScale + 0.5f));
+		const uint32_t renderSizeY = std::max(1, static_cast<int>(m_size.y * m_renderScale + 0.5f));
+		// Feedback buffers carry on from their scaled history when only the render scale changed
+		m_renderer->Resize(renderSizeX, renderSizeY, !dimensionsChanged);
+
+		if (dimensionsChanged)
+		{
+			FocusView();
+			UpdateViewport();
+		}
+
+		m_outputDirty = true;
 	}
+
+	const float totalTime = Elysium::Time::TotalTime();
+	if (m_playing)
+		m_currentTime += totalTime - m_prevTotalTime;
+	m_prevTotalTime = totalTime;
+
+	// Time changes are picked up once any in-progress tiled frame has completed
+	if (m_package->TimeDependent && m_currentTime != m_renderedTime && !IsTiledFrameInProgress())
+		m_outputDirty = true;
+
+	// New stream frames likewise
+	if (m_package->StreamRevision != m_renderedStreamRevision && !IsTiledFrameInProgress())
+		m_outputDirty = true;
 }
 
-void ViewerPanel::DrawTo(const Elysium::Shared<Elysium::Shader>& shader)
+void ViewerPanel::DrawTo(const ShaderVariants& shaders)
 {
-	if (shader)
+	SVIS_PROFILE_GPU_SCOPE("Viewer Draw");
+
+	m_currentShaders = shaders;
+
+	const Elysium::Shared<Elysium::Shader>& shader = PackageRenderer::SelectShader(shaders, m_package->BloomEnabled);
+	if (shader.get() != m_renderedShader)
+		m_outputDirty = true;
+
+	// Only re-run the shader passes when something feeding them has changed
+	if (shader && (m_outputDirty || (!m_renderOnDemand && !IsTiledFrameInProgress())))
 	{
-		if (m_package->BloomEnabled)
-		{
-			Elysium::GraphicsCalls::ClearBuffers();
-			Elysium::RenderCommands::DrawScreenShader(m_hdrfbo, shader);
+		RenderStateCache::SetFloat(shader, "u_PlaybackTime", m_currentTime);
 
-			// Blur Pass - blur the bright color values
-			bool horizontal = true;
-			uint8_t amount = 10;
-			for (uint8_t i = 0; i < amount; ++i)
-			{
-				m_blurShader->Bind();
-				m_blurShader->SetInt("horizontal", horizontal);
-
-				Elysium::GraphicsCalls::ClearBuffers();
-				Elysium::RenderCommands::DrawTexture(m_bloomFbos[(int)horizontal], Elysium::RenderCommands::TextureDrawType::Color,
-													 i == 0 ? m_hdrfbo->GetColorAttachment(1) : m_bloomFbos[(int)!horizontal]->GetColorAttachment(), 
-													 m_blurShader);
-				horizontal = !horizontal;
-			}
+		// Buffers are drawn whole once per frame, only the image pass is split into tiles
+		m_renderer->SetBufferPasses(m_package->BufferShaders, m_package->Schedule);
+		m_renderer->SetPlaybackTime(m_currentTime);
+		m_renderer->DrawBufferPasses(shader);
 
-			if (m_debugPass == DrawPass::None)
-			{
-				// Combination Pass - tonemap hdr color and blend to shader output.
-				Elysium::GraphicsCalls::ClearBuffers();
-				Elysium::RenderCommands::DrawTextures(m_shaderfbo, m_bloomShader,
-													  { m_hdrfbo->GetColorAttachment(), m_bloomFbos[(int)!horizontal]->GetColorAttachment()});
-			}
-			else
-			{
-				Elysium::Shared<Elysium::Texture2D> debugTexToDraw = nullptr;
-				if (m_debugPass == DrawPass::BrightPass)
-					debugTexToDraw = m_hdrfbo->GetColorAttachment(1);
-				else if (m_debugPass == DrawPass::BlurPass)
-					debugTexToDraw = m_bloomFbos[(int)!horizontal]->GetColorAttachment();
-
-				Elysium::GraphicsCalls::ClearBuffers();
-				Elysium::RenderCommands::DrawTexture(m_shaderfbo, Elysium::RenderCommands::TextureDrawType::Color, 
-												     debugTexToDraw, m_debugShader);
-			}
+		if (m_progressiveEnabled)
+		{
+			// Tiles are drawn over the following frames
+			m_tiledRenderer.Restart(m_renderer->GetWidth(), m_renderer->GetHeight(), m_tileSize);
 		}
 		else
 		{
-			Elysium::GraphicsCalls::ClearBuffers();
-			Elysium::RenderCommands::DrawScreenShader(m_shaderfbo, shader);
+			m_renderTimer.Begin();
+			m_renderer->Render(shader, m_debugPass);
+			m_renderTimer.End();
 		}
+
+		m_renderedShader = shader.get();
+		m_renderedTime = m_currentTime;
+		m_renderedStreamRevision = m_package->StreamRevision;
+		m_outputDirty = false;
 	}
 
-	// Draw Scene
-	if (m_fbo)
+	if (shader && IsTiledFrameInProgress())
 	{
-		m_fbo->Bind();
-		m_spriteShader->Bind();
+		// Exports may have bound their own buffers and time since the frame started
+		RenderStateCache::SetFloat(shader, "u_PlaybackTime", m_renderedTime);
+		m_renderer->BindBuffers(shader);
+		m_renderer->DrawPixelTiles(shader, m_tiledRenderer, m_tileBudgetMs);
+
+		if (m_renderer->IsBloomEnabled())
+		{
+			// Preview the finished tiles without bloom until the frame completes
+			if (m_tiledRenderer.IsComplete())
+				m_renderer->DrawPostPasses(m_debugPass);
+			else
+				m_renderer->DrawPreview();
+		}
+	}
 
-		Elysium::GraphicsCalls::ClearBuffers();
-		Elysium::GraphicsCalls::SetColor(Elysium::Math::Vec4(0.3f));
+	m_snapshot.Update();
 
-		m_scene->Draw(Elysium::Scene::SceneMask::_2D);
+	if (m_posterExporter.IsActive())
+	{
+		SVIS_PROFILE_GPU_SCOPE("Poster Export");
+		m_posterExporter.Step();
+	}
 
-		m_spriteShader->Unbind();
-		m_fbo->Unbind();
+	if (m_sequenceExporter.IsActive())
+	{
+		SVIS_PROFILE_GPU_SCOPE("Sequence Export");
+		m_sequenceExporter.Step();
 	}
 }
 
@@ -232,12 +248,28 @@ void ViewerPanel::OnImGuiRender()
 	// Re-focus
 	if (ImGui::Button(ICON_FA_COMPRESS_ARROWS_ALT, ImVec2(40, 25)))
 	{
-		FocusCamera();
-		UpdateCameraProjection();
+		FocusView();
 	}
 
 	ImGui::NextColumn();
 
+	// Snapshot status
+	const float snapshotStatusDuration = 3.0f;
+	if (m_snapshot.IsBusy())
+	{
+		ImGui::TextDisabled("Saving Snapshot...");
+	}
+	else if (m_snapshot.GetFinishedTime() >= 0.0f && Elysium::Time::TotalTime() - m_snapshot.GetFinishedTime() < snapshotStatusDuration)
+	{
+		if (m_snapshot.LastSucceeded())
+			ImGui::TextColored(ImVec4(0.2f, 1.f, 0.2f, 1.f), "Saved %s", Elysium::FileUtils::GetFileName(m_snapshot.GetFilepath(), true).c_str());
+		else
+			ImGui::TextColored(ImVec4(1.f, 0.2f, 0.2f, 1.f), "Snapshot Failed");
+
+		if (ImGui::IsItemHovered())
+			ImGui::SetTooltip(m_snapshot.GetFilepath().c_str());
+	}
+
 	ImGui::NextColumn();
 
 	if (ImGui::Button(m_playing ? ICON_FA_PAUSE : ICON_FA_PLAY, ImVec2(40, 25)))
@@ -263,15 +295,41 @@ void ViewerPanel::OnImGuiRender()
 	ImGui::Separator();
 
 	const ImVec2 panelSize = ImGui::GetContentRegionAvail();
-	ImGui::Image(reinterpret_cast<void*>(static_cast<uint64_t>(m_fbo->GetColorAttachementRendererID())), panelSize, ImVec2(0, 1), ImVec2(1, 0));
-	
-	if (m_outputSize.x != panelSize.x || m_outputSize.y != panelSize.y)
+	const ImVec2 panelMin = ImGui::GetCursorScreenPos();
+	const ImVec2 panelMax(panelMin.x + panelSize.x, panelMin.y + panelSize.y);
+	ImGui::Dummy(panelSize);
+
+	if (m_outputSize.x != static_cast<int>(panelSize.x) || m_outputSize.y != static_cast<int>(panelSize.y))
 	{
-		m_outputSize.x = static_cast<uint32_t>(panelSize.x);
-		m_outputSize.y = static_cast<uint32_t>(panelSize.y);
+		m_outputSize.x = static_cast<int>(panelSize.x);
+		m_outputSize.y = static_cast<int>(panelSize.y);
 
-		m_outputSizeChanged = true;
+		FocusView();
+	}
+
+	// Pan with the right mouse button
+	if (ImGui::IsItemHovered() && ImGui::IsMouseDragging(ImGuiMouseButton_Right, 0.0f))
+	{
+		const ImVec2 mouseDelta = ImGui::GetIO().MouseDelta;
+		m_panOffset.x += mouseDelta.x;
+		m_panOffset.y += mouseDelta.y;
 	}
+
+	// Display the shader output directly, zooming and panning only changes the drawn rect
+	const float imageWidth = m_size.x * m_zoom;
+	const float imageHeight = m_size.y * m_zoom;
+	const ImVec2 imageMin(panelMin.x + (panelSize.x - imageWidth) * 0.5f + m_panOffset.x, 
+						  panelMin.y + (panelSize.y - imageHeight) * 0.5f + m_panOffset.y);
+	const ImVec2 imageMax(imageMin.x + imageWidth, imageMin.y + imageHeight);
+
+	ImDrawList* drawList = ImGui::GetWindowDrawList();
+	drawList->PushClipRect(panelMin, panelMax, true);
+	drawList->AddRectFilled(panelMin, panelMax, IM_COL32(77, 77, 77, 255));
+	// The output may be larger than the image, which sits in its lower left corner
+	const Elysium::Math::Vec2 outputScale = m_renderer->GetOutputScale();
+	drawList->AddImage(reinterpret_cast<void*>(static_cast<uint64_t>(m_renderer->GetOutput()->GetColorAttachementRendererID())), 
+					   imageMin, imageMax, ImVec2(0, outputScale.y), ImVec2(outputScale.x, 0));
+	drawList->PopClipRect();
 	
 	m_focused = ImGui::IsWindowFocused();
 	m_hovered = ImGui::IsWindowHovered();
@@ -292,7 +350,7 @@ void ViewerPanel::OnImGuiRender()
 
 		const ImGuiWindowFlags child_flags = ImGuiWindowFlags_MenuBar;
 		const ImGuiID child_id = ImGui::GetID((void*)(intptr_t)0);
-		const bool child_is_visible = ImGui::BeginChild(child_id, ImVec2(settingsPanelWidth, 200.0f), true, child_flags);
+		const bool child_is_visible = ImGui::BeginChild(child_id, ImVec2(settingsPanelWidth, 530.0f), true, child_flags);
 		if (ImGui::BeginMenuBar())
 		{
 			ImGui::Text("Render Settings");
@@ -333,6 +391,15 @@ void ViewerPanel::OnImGuiRender()
 
 		if (m_package->BloomEnabled)
 		{
+			ImGui::SameLine();
+			ImGui::Text("Filter:");
+			ImGui::SameLine();
+			ImGui::PushItemWidth(150.f);
+			int bloomMode = static_cast<int>(m_package->BloomMode);
+			if (ImGui::Combo("##bloommode", &bloomMode, m_bloomModeStrs, (int)BloomFilterMode::Count))
+				m_package->BloomMode = static_cast<BloomFilterMode>(bloomMode);
+			ImGui::PopItemWidth();
+
 			ImGui::Text("Gamma:");
 			ImGui::SameLine();
 			ImGui::PushItemWidth(75.f);
@@ -377,8 +444,300 @@ void ViewerPanel::OnImGuiRender()
 
 		ImGui::SameLine();
 		ImGui::PushItemWidth(125.f);
-		ImGui::Combo("##debugpass", (int*)&m_debugPass, m_drawPassStrs, (int)DrawPass::Count);
+		int debugPass = static_cast<int>(m_debugPass);
+		if (ImGui::Combo("##debugpass", &debugPass, m_drawPassStrs, (int)DrawPass::Count))
+			m_debugPass = static_cast<DrawPass>(debugPass);
+		ImGui::PopItemWidth();
+
+		ImGui::Columns(1);
+
+		ImGui::Spacing();
+		ImGui::SameLine();
+		ImGui::TextColored(titleColor, "Performance");
+		ImGui::Separator();
+
+		ImGui::Columns(2, "PerformanceSettingsColumns", false);
+		ImGui::SetColumnWidth(0, 5);
+		ImGui::NextColumn();
+
+		ImGui::Text("Render On Demand:");
+		ImGui::SameLine();
+		ImGui::Checkbox("##renderondemand", &m_renderOnDemand);
+
+		if (m_renderOnDemand)
+		{
+			ImGui::SameLine();
+			ImGui::Text("Idle FPS:");
+			ImGui::SameLine();
+
+			ImGui::TextDisabled("(?)");
+			if (ImGui::IsItemHovered())
+			{
+				ImGui::BeginTooltip();
+				ImGui::PushTextWrapPos(ImGui::GetFontSize() * 35.0f);
+				ImGui::TextUnformatted("Frame rate used while the viewer is neither hovered nor focused.");
+				ImGui::PopTextWrapPos();
+				ImGui::EndTooltip();
+			}
+
+			ImGui::SameLine();
+			ImGui::PushItemWidth(75.f);
+			ImGui::InputInt("##idlefps", &m_idleFrameRate);
+			m_idleFrameRate = std::min(std::max(m_idleFrameRate, 1), 60);
+			ImGui::PopItemWidth();
+		}
+
+		ImGui::Text("Progressive:");
+		ImGui::SameLine();
+
+		ImGui::TextDisabled("(?)");
+		if (ImGui::IsItemHovered())
+		{
+			ImGui::BeginTooltip();
+			ImGui::PushTextWrapPos(ImGui::GetFontSize() * 35.0f);
+			ImGui::TextUnformatted("Renders the shader in tiles over several frames, keeping the editor responsive for expensive shaders.");
+			ImGui::PopTextWrapPos();
+			ImGui::EndTooltip();
+		}
+
+		ImGui::SameLine();
+		if (ImGui::Checkbox("##progressive", &m_progressiveEnabled))
+		{
+			m_tiledRenderer.Cancel();
+			m_outputDirty = true;
+		}
+
+		if (m_progressiveEnabled)
+		{
+			ImGui::SameLine();
+			ImGui::Text("Tile:");
+			ImGui::SameLine();
+			ImGui::PushItemWidth(50.f);
+			if (ImGui::InputScalar("##tilesize", ImGuiDataType_U32, &m_tileSize))
+			{
+				m_tileSize = std::min(std::max(m_tileSize, 16u), 4096u);
+				m_outputDirty = true;
+			}
+			ImGui::PopItemWidth();
+
+			ImGui::SameLine();
+			ImGui::Text("Budget (ms):");
+			ImGui::SameLine();
+			ImGui::PushItemWidth(50.f);
+			ImGui::DragFloat("##tilebudget", &m_tileBudgetMs, 0.5f, 1.0f, 100.0f, "%.1f");
+			ImGui::PopItemWidth();
+
+			if (IsTiledFrameInProgress())
+				ImGui::ProgressBar(m_tiledRenderer.GetProgress(), ImVec2(-1.0f, 0.0f));
+		}
+
+		ImGui::Text("Preview Scale:");
+		ImGui::SameLine();
+
+		ImGui::TextDisabled("(?)");
+		if (ImGui::IsItemHovered())
+		{
+			ImGui::BeginTooltip();
+			ImGui::PushTextWrapPos(ImGui::GetFontSize() * 35.0f);
+			ImGui::TextUnformatted("Renders the preview at a lower internal resolution. Snapshots always render at full resolution.");
+			ImGui::PopTextWrapPos();
+			ImGui::EndTooltip();
+		}
+
+		ImGui::SameLine();
+		ImGui::PushItemWidth(90.f);
+		int previewMode = static_cast<int>(m_previewMode);
+		if (ImGui::Combo("##previewscale", &previewMode, m_previewModeStrs, (int)PreviewMode::Count))
+		{
+			m_previewMode = static_cast<PreviewMode>(previewMode);
+			switch (m_previewMode)
+			{
+				case PreviewMode::Full:
+					m_renderScale = 1.0f;
+					break;
+				case PreviewMode::Half:
+					m_renderScale = 0.5f;
+					break;
+				case PreviewMode::Quarter:
+					m_renderScale = 0.25f;
+					break;
+				default:
+					break;
+			}
+		}
+		ImGui::PopItemWidth();
+
+		if (m_previewMode == PreviewMode::Adaptive)
+		{
+			ImGui::SameLine();
+			ImGui::Text("Target (ms):");
+			ImGui::SameLine();
+			ImGui::PushItemWidth(50.f);
+			ImGui::DragFloat("##targetrenderms", &m_targetRenderMs, 0.5f, 1.0f, 100.0f, "%.1f");
+			ImGui::PopItemWidth();
+			ImGui::SameLine();
+			ImGui::TextDisabled("%.0f%%", m_renderScale * 100.0f);
+		}
+
+		ImGui::Columns(1);
+
+		ImGui::Spacing();
+		ImGui::SameLine();
+		ImGui::TextColored(titleColor, "Poster Export");
+		ImGui::Separator();
+
+		ImGui::Columns(2, "ExportSettingsColumns", false);
+		ImGui::SetColumnWidth(0, 5);
+		ImGui::NextColumn();
+
+		ImGui::Text("Width:");
+		ImGui::SameLine();
+		ImGui::PushItemWidth(60.f);
+		ImGui::InputScalar("##poster_width", ImGuiDataType_U32, &m_posterSettings.Width);
+		m_posterSettings.Width = std::min(std::max(m_posterSettings.Width, 1u), PosterExportSettings::MaxDimension);
 		ImGui::PopItemWidth();
+		ImGui::SameLine();
+
+		ImGui::Text("Height:");
+		ImGui::SameLine();
+		ImGui::PushItemWidth(60.f);
+		ImGui::InputScalar("##poster_height", ImGuiDataType_U32, &m_posterSettings.Height);
+		m_posterSettings.Height = std::min(std::max(m_posterSettings.Height, 1u), PosterExportSettings::MaxDimension);
+		ImGui::PopItemWidth();
+		ImGui::SameLine();
+
+		ImGui::Text("Tile:");
+		ImGui::SameLine();
+
+		ImGui::TextDisabled("(?)");
+		if (ImGui::IsItemHovered())
+		{
+			ImGui::BeginTooltip();
+			ImGui::PushTextWrapPos(ImGui::GetFontSize() * 35.0f);
+			ImGui::TextUnformatted("Size of each rendered tile. Bloom tiles are padded so the filter blends across tile edges.");
+			ImGui::PopTextWrapPos();
+			ImGui::EndTooltip();
+		}
+
+		ImGui::SameLine();
+		ImGui::PushItemWidth(50.f);
+		ImGui::InputScalar("##poster_tile", ImGuiDataType_U32, &m_posterSettings.TileSize);
+		// Snapped once the edit is done, so sizes can be typed digit by digit
+		if (ImGui::IsItemDeactivatedAfterEdit())
+			m_posterSettings.TileSize = PosterExporter::ClampTileSize(m_posterSettings.TileSize);
+		ImGui::PopItemWidth();
+
+		if (m_posterExporter.IsActive())
+		{
+			if (ImGui::Button("Cancel##poster"))
+				m_posterExporter.Cancel();
+			ImGui::SameLine();
+			ImGui::ProgressBar(m_posterExporter.GetProgress(), ImVec2(-1.0f, 0.0f));
+		}
+		else if (ImGui::Button("Export Poster"))
+		{
+			ExportPoster();
+		}
+
+		ImGui::Columns(1);
+
+		ImGui::Spacing();
+		ImGui::SameLine();
+		ImGui::TextColored(titleColor, "Sequence Export");
+		ImGui::Separator();
+
+		ImGui::Columns(2, "SequenceSettingsColumns", false);
+		ImGui::SetColumnWidth(0, 5);
+		ImGui::NextColumn();
+
+		ImGui::Text("Frames:");
+		ImGui::SameLine();
+		ImGui::PushItemWidth(50.f);
+		ImGui::InputScalar("##sequence_frames", ImGuiDataType_U32, &m_sequenceSettings.FrameCount);
+		m_sequenceSettings.FrameCount = std::min(std::max(m_sequenceSettings.FrameCount, 1u), 100000u);
+		ImGui::PopItemWidth();
+		ImGui::SameLine();
+
+		ImGui::Text("FPS:");
+		ImGui::SameLine();
+		ImGui::PushItemWidth(50.f);
+		ImGui::DragFloat("##sequence_fps", &m_sequenceSettings.FrameRate, 1.0f, 1.0f, 240.0f, "%.0f");
+		ImGui::PopItemWidth();
+		ImGui::SameLine();
+
+		ImGui::Text("Start:");
+		ImGui::SameLine();
+
+		ImGui::TextDisabled("(?)");
+		if (ImGui::IsItemHovered())
+		{
+			ImGui::BeginTooltip();
+			ImGui::PushTextWrapPos(ImGui::GetFontSize() * 35.0f);
+			ImGui::TextUnformatted("TIME of the first frame, each following frame advances by 1 / FPS regardless of how long it takes to render.");
+			ImGui::PopTextWrapPos();
+			ImGui::EndTooltip();
+		}
+
+		ImGui::SameLine();
+		ImGui::PushItemWidth(50.f);
+		ImGui::DragFloat("##sequence_start", &m_sequenceSettings.StartTime, 0.1f, 0.0f, 0.0f, "%.2f");
+		ImGui::PopItemWidth();
+
+		ImGui::Text("Format:");
+		ImGui::SameLine();
+		ImGui::PushItemWidth(125.f);
+		int sequenceFormat = static_cast<int>(m_sequenceSettings.Format);
+		if (ImGui::Combo("##sequence_format", &sequenceFormat, m_sequenceFormatStrs, (int)SequenceFormat::Count))
+			m_sequenceSettings.Format = static_cast<SequenceFormat>(sequenceFormat);
+		ImGui::PopItemWidth();
+
+		if (m_sequenceExporter.IsActive())
+		{
+			if (ImGui::Button("Cancel##sequence"))
+				m_sequenceExporter.Cancel();
+			ImGui::SameLine();
+			ImGui::ProgressBar(m_sequenceExporter.GetProgress(), ImVec2(-1.0f, 0.0f));
+		}
+		else if (ImGui::Button("Export Sequence"))
+		{
+			ExportSequence();
+		}
+
+		ImGui::Columns(1);
+
+		ImGui::Spacing();
+		ImGui::SameLine();
+		ImGui::TextColored(titleColor, "HDR Export");
+		ImGui::Separator();
+
+		ImGui::Columns(2, "HdrSettingsColumns", false);
+		ImGui::SetColumnWidth(0, 5);
+		ImGui::NextColumn();
+
+		ImGui::Text("Bright Pass:");
+		ImGui::SameLine();
+		ImGui::Checkbox("##hdr_bright", &m_hdrExportBright);
+		ImGui::SameLine();
+
+		ImGui::Text("Bloom:");
+		ImGui::SameLine();
+		ImGui::Checkbox("##hdr_bloom", &m_hdrExportBloom);
+		ImGui::SameLine();
+
+		ImGui::TextDisabled("(?)");
+		if (ImGui::IsItemHovered())
+		{
+			ImGui::BeginTooltip();
+			ImGui::PushTextWrapPos(ImGui::GetFontSize() * 35.0f);
+			ImGui::TextUnformatted("Writes the linear, pre-tonemap color as a half float OpenEXR. The bright pass and blurred bloom buffers are written next to it with _bright and _bloom suffixes.");
+			ImGui::PopTextWrapPos();
+			ImGui::EndTooltip();
+		}
+
+		if (ImGui::Button("Export HDR") && !m_snapshot.IsBusy())
+		{
+			ExportHdr();
+		}
 
 		ImGui::EndChild();
 		ImGui::EndGroup();
@@ -401,63 +760,226 @@ void ViewerPanel::OnEvent(Elysium::Event& _event)
 bool ViewerPanel::OnMouseScroll(Elysium::MouseScrolledEvent& _event)
 {
 	const float delta = _event.GetYOffset();
-	m_orthoSize -= delta * m_zoomModifier;
-
-	if (m_orthoSize < 10.0f)
-		m_orthoSize = 10.0f;
-
-	UpdateCameraProjection();
+	m_zoom *= std::pow(m_zoomModifier, delta);
+	m_zoom = std::min(std::max(m_zoom, 0.01f), 64.0f);
 
 	return false;
 }
 
-void ViewerPanel::UpdateCameraProjection()
+void ViewerPanel::UpdateViewport()
 {
-	const float aspectRatio = m_outputSize.x / (float)m_outputSize.y;
-
-	m_camera->SetProperties(aspectRatio, m_orthoSize);
-
 	Elysium::CameraData& cameraRef = Elysium::CoreUniformBuffers::GetCameraDataRef();
-	cameraRef.m_viewport = Elysium::Math::Vec4((float)m_package->Dimensions.x, (float)m_package->Dimensions.y, 0, 0);
-	cameraRef.m_orthoProjectionMatrix = m_camera->GetProjection();
+	cameraRef.m_viewport = Elysium::Math::Vec4((float)m_size.x, (float)m_size.y, 0, 0);
 }
 
-void ViewerPanel::UpdateCameraView()
+void ViewerPanel::FocusView()
 {
-	m_camera->SetPosition(Elysium::Math::Vec2(0, 0));
+	// Fit the whole output within the panel
+	const float fitX = m_outputSize.x / static_cast<float>(std::max(m_size.x, 1));
+	const float fitY = m_outputSize.y / static_cast<float>(std::max(m_size.y, 1));
+	m_zoom = std::max(std::min(fitX, fitY), 0.01f);
 
-	Elysium::CameraData& cameraRef = Elysium::CoreUniformBuffers::GetCameraDataRef();
-	cameraRef.m_orthoViewMatrix = m_camera->GetView();
+	m_panOffset = Elysium::Math::Vec2(0, 0);
 }
 
-void ViewerPanel::FocusCamera()
+void ViewerPanel::UpdateAdaptiveScale()
 {
-	m_orthoSize = static_cast<float>(std::max(m_package->Dimensions.x, m_package->Dimensions.y));
+	// Only whole frames are timed. Progressive tiles already keep each frame within their budget,
+	// so while tiled rendering is on the scale holds where it was.
+	bool hasResult = false;
+	float renderMs = 0.0f;
+	while (m_renderTimer.TryGetResult(renderMs))
+	{
+		m_lastRenderMs = renderMs;
+		hasResult = true;
+	}
+
+	// Hold each scale for a moment so the targets aren't reallocated every frame
+	const float totalTime = Elysium::Time::TotalTime();
+	if (!hasResult || totalTime - m_lastScaleChangeTime < 0.5f)
+		return;
+
+	// Snap to sixteenths to avoid reallocating for tiny changes, away from the current scale so
+	// every step moves it by at least one
+	float scale = m_renderScale;
+	if (m_lastRenderMs > m_targetRenderMs * 1.1f)
+		scale = std::floor(scale * std::sqrt(m_targetRenderMs / m_lastRenderMs) * 16.0f) / 16.0f;	// Cost scales with the pixel count
+	else if (m_lastRenderMs < m_targetRenderMs * 0.6f)
+		scale = std::ceil(scale * 1.1f * 16.0f) / 16.0f;
+	scale = std::min(std::max(scale, 0.25f), 1.0f);
+
+	if (scale != m_renderScale)
+	{
+		m_renderScale = scale;
+		m_lastScaleChangeTime = totalTime;
+	}
 }
 
-void ViewerPanel::SnapShot()
+const Elysium::Shared<Elysium::FrameBuffer>& ViewerPanel::RenderFullResolution()
 {
-	// Retrieve the fbo data that represents the rotated normals
-	const uint32_t img_width = m_shaderfbo->GetColorAttachment(0)->GetWidth();
-	const uint32_t img_height = m_shaderfbo->GetColorAttachment(0)->GetHeight();
+	// The preview already holds a complete full resolution frame
+	if (m_appliedRenderScale == 1.0f && m_size == m_package->Dimensions && !m_outputDirty && !IsTiledFrameInProgress())
+		return m_renderer->GetOutput();
+
+	if (!m_exportRenderer)
+		m_exportRenderer = Elysium::CreateUnique<PackageRenderer>();
+
+	m_exportRenderer->Resize(m_package->Dimensions.x, m_package->Dimensions.y);
+	m_exportRenderer->SetBloom(m_package->BloomEnabled, m_package->BloomMode);
 
-	cv::Mat currentImage(img_height, img_width, CV_8UC4, cv::Scalar(255, 255, 255, 0));
+	const Elysium::Shared<Elysium::Shader>& shader = PackageRenderer::SelectShader(m_currentShaders, m_package->BloomEnabled);
+	if (shader)
+	{
+		RenderStateCache::SetFloat(shader, "u_PlaybackTime", m_renderedTime);
+
+		// The preview's viewport may still trail the package while a resize settles
+		Elysium::CameraData& cameraRef = Elysium::CoreUniformBuffers::GetCameraDataRef();
+		const Elysium::Math::Vec4 prevViewport = cameraRef.m_viewport;
+		cameraRef.m_viewport = Elysium::Math::Vec4((float)m_package->Dimensions.x, (float)m_package->Dimensions.y, 0, 0);
+		Elysium::CoreUniformBuffers::UploadDirtyData();
+
+		// Streams are read at the rendered time, their own textures may already hold a later frame
+		const VideoStream::SlotFrames streamFrames = VideoStream::ReadSlotFrames(m_package->Textures, m_renderedTime);
+		VideoStream::BindSlotFrames(streamFrames);
+
+		DrawExportBuffers(shader);
+		m_exportRenderer->Render(shader, m_debugPass);
 
-	const uint32_t datasize = img_width * img_height * 4;
-	m_shaderfbo->Bind();
-	uint8_t* pixelData = m_shaderfbo->ReadPixelBuffer(0, 0, 0, img_width, img_height);
-	m_shaderfbo->Unbind();
-	std::memcpy(currentImage.data, pixelData, datasize);
-	delete[] pixelData;
+		cameraRef.m_viewport = prevViewport;
+		Elysium::CoreUniformBuffers::UploadDirtyData();
+	}
+	return m_exportRenderer->GetOutput();
+}
+
+void ViewerPanel::DrawExportBuffers(const Elysium::Shared<Elysium::Shader>& shader)
+{
+	// Buffers are drawn again at the export resolution rather than sampled at the preview's,
+	// as a single frame from black like the first frame of a sequence export
+	m_exportRenderer->SetBufferPasses(m_package->BufferShaders, m_package->Schedule);
+	m_exportRenderer->ResetBuffers();
+	m_exportRenderer->SetPlaybackTime(m_renderedTime);
+	m_exportRenderer->DrawBufferPasses(shader);
+}
 
-	cv::Mat convertedImg;
-	cv::cvtColor(currentImage, convertedImg, cv::COLOR_RGBA2BGRA);
-	currentImage.release();
+void ViewerPanel::SnapShot()
+{
+	if (m_snapshot.IsBusy())
+		return;
 
 	const std::string outputFilepath = Elysium::FileDialogs::SaveFile("PNG Image (*.png)\0*.png\0"
 																	  "JPEG Image (*.jpg, *.jpeg, *.jpe)\0*.jpg;*.jpeg;*.jpe\0");
+	if (outputFilepath.empty())
+		return;
+
+	// Snapshots are always taken at the full package resolution
+	const Elysium::Shared<Elysium::FrameBuffer> outputfbo = RenderFullResolution();
+
+	// The preview's targets can be larger than the image, only the package dimensions are read
+	const uint32_t img_width = m_package->Dimensions.x;
+	const uint32_t img_height = m_package->Dimensions.y;
+
+	// The pixels are read back and encoded over the following frames
+	m_snapshot.Begin(outputfbo, img_width, img_height, outputFilepath);
+
+	// The queued copy is ordered ahead of releasing the export targets
+	if (m_exportRenderer)
+		m_exportRenderer->Release();
+}
+
+void ViewerPanel::ExportPoster()
+{
+	const Elysium::Shared<Elysium::Shader>& shader = PackageRenderer::SelectShader(m_currentShaders, m_package->BloomEnabled);
+	if (!shader)
+	{
+		ELYSIUM_WARN("Poster Export Requires a Compiled Shader");
+		return;
+	}
+
+	const std::string outputFilepath = Elysium::FileDialogs::SaveFile("TIFF Image (*.tif, *.tiff)\0*.tif;*.tiff\0");
+	if (outputFilepath.empty())
+		return;
+
+	// Tiles are rendered over the following frames
+	m_posterExporter.Begin(outputFilepath, m_posterSettings, shader, m_package->BufferShaders, m_package->Schedule,
+						   m_package->Textures, m_package->BloomEnabled, m_package->BloomMode, m_renderedTime);
+}
+
+void ViewerPanel::ExportSequence()
+{
+	const Elysium::Shared<Elysium::Shader>& shader = PackageRenderer::SelectShader(m_currentShaders, m_package->BloomEnabled);
+	if (!shader)
+	{
+		ELYSIUM_WARN("Sequence Export Requires a Compiled Shader");
+		return;
+	}
+
+	std::string outputFilepath;
+	if (m_sequenceSettings.Format == SequenceFormat::Video)
+		outputFilepath = Elysium::FileDialogs::SaveFile("MP4 Video (*.mp4)\0*.mp4\0"
+														"AVI Video (*.avi)\0*.avi\0");
+	else
+		outputFilepath = Elysium::FileDialogs::SaveFile("PNG Image (*.png)\0*.png\0");
+
+	if (outputFilepath.empty())
+		return;
 
-	ELYSIUM_INFO("Writing Snapshot to {0}", outputFilepath);
-	cv::imwrite(outputFilepath, convertedImg);
-	convertedImg.release();
+	// Frames are rendered, read back and encoded over the following frames
+	m_sequenceExporter.Begin(outputFilepath, m_sequenceSettings, shader, m_package->BufferShaders, m_package->Schedule,
+							 m_package->BloomEnabled, m_package->BloomMode, m_package->Dimensions);
 }
+
+void ViewerPanel::ExportHdr()
+{
+	// Only the bloom variant renders to the half float targets
+	const Elysium::Shared<Elysium::Shader>& shader = PackageRenderer::SelectShader(m_currentShaders, true);
+	if (!shader)
+	{
+		ELYSIUM_WARN("HDR Export Requires a Compiled Shader");
+		return;
+	}
+
+	const std::string outputFilepath = Elysium::FileDialogs::SaveFile("OpenEXR Image (*.exr)\0*.exr\0");
+	if (outputFilepath.empty())
+		return;
+
+	if (!m_exportRenderer)
+		m_exportRenderer = Elysium::CreateUnique<PackageRenderer>();
+
+	m_exportRenderer->Resize(m_package->Dimensions.x, m_package->Dimensions.y);
+	m_exportRenderer->SetBloom(true, m_package->BloomMode);
+
+	RenderStateCache::SetFloat(shader, "u_PlaybackTime", m_renderedTime);
+
+	Elysium::CameraData& cameraRef = Elysium::CoreUniformBuffers::GetCameraDataRef();
+	const Elysium::Math::Vec4 prevViewport = cameraRef.m_viewport;
+	cameraRef.m_viewport = Elysium::Math::Vec4((float)m_package->Dimensions.x, (float)m_package->Dimensions.y, 0, 0);
+	Elysium::CoreUniformBuffers::UploadDirtyData();
+
+	const VideoStream::SlotFrames streamFrames = VideoStream::ReadSlotFrames(m_package->Textures, m_renderedTime);
+	VideoStream::BindSlotFrames(streamFrames);
+
+	DrawExportBuffers(shader);
+	m_exportRenderer->Render(shader);
+
+	cameraRef.m_viewport = prevViewport;
+	Elysium::CoreUniformBuffers::UploadDirtyData();
+
+	// name.exr -> name_bright.exr, name_bloom.exr
+	const std::filesystem::path basePath(outputFilepath);
+	const auto getLayerPath = [&basePath](const char* suffix)
+	{
+		return (basePath.parent_path() / (basePath.stem().string() + suffix + ".exr")).string();
+	};
+
+	std::vector<AsyncSnapshot::HdrLayer> layers;
+	layers.push_back({ m_exportRenderer->GetHdrOutput()->GetColorAttachment(0), getLayerPath("") });
+	if (m_hdrExportBright)
+		layers.push_back({ m_exportRenderer->GetHdrOutput()->GetColorAttachment(1), getLayerPath("_bright") });
+	if (m_hdrExportBloom)
+		layers.push_back({ m_exportRenderer->GetBloomOutput(), getLayerPath("_bloom") });
+
+	// The half float data is read back and written over the following frames
+	m_snapshot.BeginHdr(layers);
+
+	m_exportRenderer->Release();
+}
\ No newline at end of file
@@ -2,75 +2,135 @@
 
 #include "Elysium.h"
 
-#include "Elysium/Scene/2DComponents.h"
-
-struct ShaderPackage;
+#include "ShaderPackage.h"
+#include "Rendering/PackageRenderer.h"
+#include "Rendering/TiledRenderer.h"
+#include "Profiling/GpuTimer.h"
+#include "Export/PosterExporter.h"
+#include "Export/SequenceExporter.h"
+#include "Export/AsyncSnapshot.h"
 
 class ViewerPanel
 {
+public:
+	// How long the dimensions have to stay unchanged before the targets follow them
+	static constexpr float ResizeSettleDelay = 0.25f;
+	// Target capacity is rounded up to this, so nearby sizes reuse the same storage
+	static constexpr uint32_t TargetCapacityStep = 256;
 public:
 	ViewerPanel(ShaderPackage* package);
+	~ViewerPanel();
 public:
 	void OnUpdate();
-	void DrawTo(const Elysium::Shared<Elysium::Shader>& shader);
+	void DrawTo(const ShaderVariants& shaders);
 
 	inline bool IsFocused() const { return m_focused; }
 	inline bool IsHovered() const { return m_hovered; }
+
+	inline bool IsIdle() const { return m_renderOnDemand && !m_focused && !m_hovered && !m_posterExporter.IsActive() && !m_sequenceExporter.IsActive() && !m_snapshot.IsBusy(); }
+	inline int GetIdleFrameRate() const { return m_idleFrameRate; }
+	inline float GetPlaybackTime() const { return m_currentTime; }
 public:
 	void OnImGuiRender();
 	void OnEvent(Elysium::Event& _event);
 private:
 	bool OnMouseScroll(Elysium::MouseScrolledEvent& _event);
 
-	void UpdateCameraProjection();
-	void UpdateCameraView();
-	void FocusCamera();
+	void UpdateViewport();
+	void FocusView();
+
+	void UpdateAdaptiveScale();
+	const Elysium::Shared<Elysium::FrameBuffer>& RenderFullResolution();
+	void DrawExportBuffers(const Elysium::Shared<Elysium::Shader>& shader);
+
+	inline bool IsTiledFrameInProgress() const { return m_progressiveEnabled && !m_tiledRenderer.IsComplete(); }
 
 	void SnapShot();
+	void ExportPoster();
+	void ExportSequence();
+	void ExportHdr();
 private:
 	ShaderPackage* m_package;
 
+	// Dimensions the targets were last resized to, trailing the package while edits settle
 	Elysium::Math::iVec2 m_size;
+	Elysium::Math::iVec2 m_requestedSize;
+	float m_resizeRequestTime;
 	Elysium::Math::iVec2 m_outputSize;
-	bool m_outputSizeChanged;
-
-	Elysium::Shared<Elysium::Scene> m_scene;
-	Elysium::Entity m_sprite;
 
-	Elysium::Shared<Elysium::FrameBuffer> m_hdrfbo;
-	std::array<Elysium::Shared<Elysium::FrameBuffer>, 2> m_bloomFbos;
-	Elysium::Shared<Elysium::FrameBuffer> m_fbo;
-	Elysium::Shared<Elysium::FrameBuffer> m_shaderfbo;
+	Elysium::Unique<PackageRenderer> m_renderer;
+	Elysium::Unique<PackageRenderer> m_exportRenderer;
+	ShaderVariants m_currentShaders;
 
-	Elysium::Shared<Elysium::Shader> m_blurShader;
-	Elysium::Shared<Elysium::Shader> m_bloomShader;
-	Elysium::Shared<Elysium::Shader> m_spriteShader;
+	const char* m_bloomModeStrs[2] = { "Gaussian (Reference)", "Mip Chain" };
 
-	Elysium::Shared<Elysium::OrthographicCamera>  m_camera;
-
-	float m_orthoSize;
+	float m_zoom;
 	float m_zoomModifier;
+	Elysium::Math::Vec2 m_panOffset;
 
 	bool m_focused;
 	bool m_hovered;
 
 	float m_currentTime;
+	float m_prevTotalTime;
 	float m_prevGamma;
 	float m_prevExposure;
 
-	bool m_playing;
-	bool m_settingsVisible;
-
-	// Debug
-	enum class DrawPass : uint8_t
+	// Render On Demand
+	bool m_renderOnDemand;
+	int m_idleFrameRate;
+	bool m_outputDirty;
+	float m_renderedTime;
+	uint32_t m_renderedRevision;
+	uint32_t m_renderedStreamRevision;
+	const Elysium::Shader* m_renderedShader;
+	bool m_prevBloomEnabled;
+	BloomFilterMode m_prevBloomMode;
+
+	// Progressive Rendering
+	bool m_progressiveEnabled;
+	uint32_t m_tileSize;
+	float m_tileBudgetMs;
+	TiledRenderer m_tiledRenderer;
+
+	// Dynamic Resolution
+	enum class PreviewMode : uint8_t
 	{
-		None,
-		BrightPass,
-		BlurPass,
+		Full,
+		Half,
+		Quarter,
+		Adaptive,
 
 		Count
 	};
+	const char* m_previewModeStrs[4] = { "Full", "1/2", "1/4", "Adaptive" };
+	PreviewMode m_previewMode;
+	float m_renderScale;
+	float m_appliedRenderScale;
+	float m_targetRenderMs;
+	float m_lastRenderMs;
+	float m_lastScaleChangeTime;
+	GpuTimer m_renderTimer;
+
+	AsyncSnapshot m_snapshot;
+	bool m_hdrExportBright;
+	bool m_hdrExportBloom;
+
+	// Poster Export
+	PosterExportSettings m_posterSettings;
+	PosterExporter m_posterExporter;
+
+	// Sequence Export
+	const char* m_sequenceFormatStrs[2] = { "PNG Sequence", "Video" };
+	SequenceExportSettings m_sequenceSettings;
+	SequenceExporter m_sequenceExporter;
+
+	bool m_playing;
+	bool m_settingsVisible;
+
+	// Debug
+	using DrawPass = PackageRenderer::DrawPass;
 	const char* m_drawPassStrs[3] = { "None", "Bright Pixels", "Blurring" };
 	DrawPass m_debugPass;
-	Elysium::Shared<Elysium::Shader> m_debugShader;
-};
+	DrawPass m_prevDebugPass;
+};
\ No newline at end of file
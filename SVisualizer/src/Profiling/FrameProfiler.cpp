@@ -0,0 +1,293 @@
+#include "svis_pch.h"
+#include "FrameProfiler.h"
+
+#include "Elysium.h"
+
+#include <glad/glad.h>
+
+#include <limits>
+
+SampleHistory::SampleHistory()
+	: Count(0),
+	Offset(0)
+{
+	Samples.fill(0.0f);
+}
+
+void SampleHistory::Push(float sample)
+{
+	Samples[Offset] = sample;
+	Offset = (Offset + 1) % Capacity;
+	Count = std::min(Count + 1, Capacity);
+}
+
+void SampleHistory::Clear()
+{
+	Samples.fill(0.0f);
+	Count = 0;
+	Offset = 0;
+}
+
+float SampleHistory::Latest() const
+{
+	if (Count == 0)
+		return 0.0f;
+	return Samples[(Offset + Capacity - 1) % Capacity];
+}
+
+float SampleHistory::Average() const
+{
+	if (Count == 0)
+		return 0.0f;
+
+	float total = 0.0f;
+	for (uint32_t i = 0; i < Count; ++i)
+		total += Samples[i];
+	return total / Count;
+}
+
+float SampleHistory::Percentile(float percentile) const
+{
+	if (Count == 0)
+		return 0.0f;
+
+	std::array<float, Capacity> sorted;
+	std::copy(Samples.begin(), Samples.begin() + Count, sorted.begin());
+
+	const uint32_t rank = std::min(static_cast<uint32_t>(percentile / 100.0f * Count), Count - 1);
+	std::nth_element(sorted.begin(), sorted.begin() + rank, sorted.begin() + Count);
+	return sorted[rank];
+}
+
+void SampleHistory::CopyOrdered(std::vector<float>& output) const
+{
+	output.resize(Count);
+
+	// Before wrapping around the oldest sample sits at the front
+	const uint32_t start = Count < Capacity ? 0 : Offset;
+	for (uint32_t i = 0; i < Count; ++i)
+		output[i] = Samples[(start + i) % Capacity];
+}
+
+static constexpr uint32_t InvalidSection = std::numeric_limits<uint32_t>::max();
+
+struct PendingGpuSection
+{
+	uint32_t SectionIndex;
+	GLuint BeginQuery;
+	GLuint EndQuery;
+};
+
+struct FrameQueries
+{
+	std::vector<GLuint> Pool;
+	uint32_t Used = 0;
+
+	std::vector<PendingGpuSection> Pending;
+};
+
+struct OpenSection
+{
+	uint32_t SectionIndex;
+	std::chrono::steady_clock::time_point Start;
+	GLuint BeginQuery;
+};
+
+struct FrameProfilerData
+{
+	bool Enabled = false;
+
+	std::vector<FrameProfiler::Section> Sections;
+	std::unordered_map<std::string, uint32_t> SectionLookup;
+	std::vector<OpenSection> OpenSections;
+
+	std::array<FrameQueries, FrameProfiler::QueryLatency> Frames;
+	uint32_t FrameIndex = 0;
+
+	SampleHistory FrameTimes;
+	std::chrono::steady_clock::time_point FrameStart;
+	bool FrameStarted = false;
+
+	uint32_t DroppedGpuResults = 0;
+};
+
+static FrameProfilerData s_data;
+
+static GLuint AcquireQuery(FrameQueries& frame)
+{
+	if (frame.Used == frame.Pool.size())
+	{
+		GLuint query = 0;
+		glGenQueries(1, &query);
+		frame.Pool.push_back(query);
+	}
+	return frame.Pool[frame.Used++];
+}
+
+static void CollectGpuResults(FrameQueries& frame)
+{
+	for (const PendingGpuSection& pending : frame.Pending)
+	{
+		// Never wait on the gpu, results that are still not ready are dropped
+		GLint available = 0;
+		glGetQueryObjectiv(pending.EndQuery, GL_QUERY_RESULT_AVAILABLE, &available);
+		if (!available)
+		{
+			++s_data.DroppedGpuResults;
+			continue;
+		}
+
+		GLuint64 beginTime = 0;
+		GLuint64 endTime = 0;
+		glGetQueryObjectui64v(pending.BeginQuery, GL_QUERY_RESULT, &beginTime);
+		glGetQueryObjectui64v(pending.EndQuery, GL_QUERY_RESULT, &endTime);
+
+		const float elapsedMs = static_cast<float>(endTime - beginTime) / 1000000.0f;
+		s_data.Sections[pending.SectionIndex].GpuTimes.Push(elapsedMs);
+	}
+
+	frame.Pending.clear();
+	frame.Used = 0;
+}
+
+void FrameProfiler::Shutdown()
+{
+	for (FrameQueries& frame : s_data.Frames)
+	{
+		if (!frame.Pool.empty())
+			glDeleteQueries(static_cast<GLsizei>(frame.Pool.size()), frame.Pool.data());
+
+		frame.Pool.clear();
+		frame.Pending.clear();
+		frame.Used = 0;
+	}
+}
+
+void FrameProfiler::BeginFrame()
+{
+	if (!s_data.Enabled)
+		return;
+
+	const auto now = std::chrono::steady_clock::now();
+	if (s_data.FrameStarted)
+		s_data.FrameTimes.Push(std::chrono::duration<float, std::milli>(now - s_data.FrameStart).count());
+
+	s_data.FrameStart = now;
+	s_data.FrameStarted = true;
+
+	// The slot being reused was filled QueryLatency frames ago
+	s_data.FrameIndex = (s_data.FrameIndex + 1) % QueryLatency;
+	CollectGpuResults(s_data.Frames[s_data.FrameIndex]);
+}
+
+void FrameProfiler::EndFrame()
+{
+	if (!s_data.OpenSections.empty())
+	{
+		ELYSIUM_WARN("Profiler frame ended with {0} unclosed sections.", s_data.OpenSections.size());
+		s_data.OpenSections.clear();
+	}
+}
+
+uint32_t FrameProfiler::BeginSection(const char* name, bool gpuTiming)
+{
+	if (!s_data.Enabled)
+		return InvalidSection;
+
+	uint32_t sectionIndex = 0;
+	auto lookup = s_data.SectionLookup.find(name);
+	if (lookup == s_data.SectionLookup.end())
+	{
+		sectionIndex = static_cast<uint32_t>(s_data.Sections.size());
+		s_data.SectionLookup[name] = sectionIndex;
+
+		Section& section = s_data.Sections.emplace_back();
+		section.Name = name;
+		section.Depth = static_cast<uint32_t>(s_data.OpenSections.size());
+		section.HasGpuTiming = false;
+	}
+	else
+	{
+		sectionIndex = lookup->second;
+	}
+
+	OpenSection openSection;
+	openSection.SectionIndex = sectionIndex;
+	openSection.BeginQuery = 0;
+	if (gpuTiming)
+	{
+		openSection.BeginQuery = AcquireQuery(s_data.Frames[s_data.FrameIndex]);
+		glQueryCounter(openSection.BeginQuery, GL_TIMESTAMP);
+
+		s_data.Sections[sectionIndex].HasGpuTiming = true;
+	}
+	openSection.Start = std::chrono::steady_clock::now();
+
+	s_data.OpenSections.push_back(openSection);
+	return sectionIndex;
+}
+
+void FrameProfiler::EndSection(uint32_t sectionIndex, bool gpuTiming)
+{
+	if (sectionIndex == InvalidSection || s_data.OpenSections.empty())
+		return;
+
+	const OpenSection openSection = s_data.OpenSections.back();
+	s_data.OpenSections.pop_back();
+
+	const auto now = std::chrono::steady_clock::now();
+	s_data.Sections[sectionIndex].CpuTimes.Push(std::chrono::duration<float, std::milli>(now - openSection.Start).count());
+
+	if (gpuTiming && openSection.BeginQuery != 0)
+	{
+		FrameQueries& frame = s_data.Frames[s_data.FrameIndex];
+
+		PendingGpuSection pending;
+		pending.SectionIndex = sectionIndex;
+		pending.BeginQuery = openSection.BeginQuery;
+		pending.EndQuery = AcquireQuery(frame);
+		glQueryCounter(pending.EndQuery, GL_TIMESTAMP);
+
+		frame.Pending.push_back(pending);
+	}
+}
+
+void FrameProfiler::Reset()
+{
+	for (Section& section : s_data.Sections)
+	{
+		section.CpuTimes.Clear();
+		section.GpuTimes.Clear();
+	}
+	s_data.FrameTimes.Clear();
+	s_data.DroppedGpuResults = 0;
+}
+
+bool FrameProfiler::IsEnabled()
+{
+	return s_data.Enabled;
+}
+
+void FrameProfiler::SetEnabled(bool enabled)
+{
+	s_data.Enabled = enabled;
+
+	// Avoid counting the time spent disabled as a single long frame
+	s_data.FrameStarted = false;
+	s_data.OpenSections.clear();
+}
+
+const std::vector<FrameProfiler::Section>& FrameProfiler::GetSections()
+{
+	return s_data.Sections;
+}
+
+const SampleHistory& FrameProfiler::GetFrameTimes()
+{
+	return s_data.FrameTimes;
+}
+
+uint32_t FrameProfiler::GetDroppedGpuResults()
+{
+	return s_data.DroppedGpuResults;
+}
\ No newline at end of file
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <array>
+#include <string>
+#include <vector>
+
+// Fixed size rolling window of timing samples in milliseconds.
+struct SampleHistory
+{
+public:
+	static constexpr uint32_t Capacity = 240;
+public:
+	SampleHistory();
+public:
+	void Push(float sample);
+	void Clear();
+
+	float Latest() const;
+	float Average() const;
+	float Percentile(float percentile) const;
+
+	// Copies the samples oldest first, used for plotting
+	void CopyOrdered(std::vector<float>& output) const;
+public:
+	std::array<float, Capacity> Samples;
+	uint32_t Count;
+	uint32_t Offset;
+};
+
+// Collects scoped cpu timings and gpu timestamp queries for each named section of a frame.
+class FrameProfiler
+{
+public:
+	// Number of frames gpu queries are left in flight before their results are read
+	static constexpr uint32_t QueryLatency = 3;
+public:
+	struct Section
+	{
+	public:
+		std::string Name;
+		uint32_t Depth;
+		bool HasGpuTiming;
+
+		SampleHistory CpuTimes;
+		SampleHistory GpuTimes;
+	};
+public:
+	static void Shutdown();
+
+	static void BeginFrame();
+	static void EndFrame();
+
+	static uint32_t BeginSection(const char* name, bool gpuTiming);
+	static void EndSection(uint32_t sectionIndex, bool gpuTiming);
+
+	static void Reset();
+
+	static bool IsEnabled();
+	static void SetEnabled(bool enabled);
+
+	static const std::vector<Section>& GetSections();
+	static const SampleHistory& GetFrameTimes();
+	static uint32_t GetDroppedGpuResults();
+};
+
+class ProfileScope
+{
+public:
+	ProfileScope(const char* name, bool gpuTiming = false)
+		: m_gpuTiming(gpuTiming)
+	{
+		m_sectionIndex = FrameProfiler::BeginSection(name, gpuTiming);
+	}
+
+	~ProfileScope()
+	{
+		FrameProfiler::EndSection(m_sectionIndex, m_gpuTiming);
+	}
+private:
+	uint32_t m_sectionIndex;
+	bool m_gpuTiming;
+};
+
+#define SVIS_PROFILE_CONCAT_INNER(a, b) a##b
+#define SVIS_PROFILE_CONCAT(a, b) SVIS_PROFILE_CONCAT_INNER(a, b)
+
+#define SVIS_PROFILE_SCOPE(name) ProfileScope SVIS_PROFILE_CONCAT(profileScope, __LINE__)(name)
+#define SVIS_PROFILE_GPU_SCOPE(name) ProfileScope SVIS_PROFILE_CONCAT(profileScope, __LINE__)(name, true)
\ No newline at end of file
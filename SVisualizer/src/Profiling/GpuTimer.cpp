@@ -0,0 +1,66 @@
+#include "svis_pch.h"
+#include "GpuTimer.h"
+
+#include <glad/glad.h>
+
+GpuTimer::GpuTimer()
+	: m_queries(),
+	m_created(false),
+	m_writeIndex(0),
+	m_pendingCount(0)
+{
+}
+
+GpuTimer::~GpuTimer()
+{
+	if (m_created)
+		glDeleteQueries(Latency * 2, m_queries[0].data());
+}
+
+void GpuTimer::Begin()
+{
+	if (!m_created)
+	{
+		glGenQueries(Latency * 2, m_queries[0].data());
+		m_created = true;
+	}
+
+	// Drop the oldest measurement when every query is still in flight
+	if (m_pendingCount == Latency)
+		--m_pendingCount;
+
+	glQueryCounter(m_queries[m_writeIndex][0], GL_TIMESTAMP);
+}
+
+void GpuTimer::End()
+{
+	if (!m_created)
+		return;
+
+	glQueryCounter(m_queries[m_writeIndex][1], GL_TIMESTAMP);
+
+	m_writeIndex = (m_writeIndex + 1) % Latency;
+	++m_pendingCount;
+}
+
+bool GpuTimer::TryGetResult(float& elapsedMs)
+{
+	if (m_pendingCount == 0)
+		return false;
+
+	const uint32_t readIndex = (m_writeIndex + Latency - m_pendingCount) % Latency;
+
+	GLint available = 0;
+	glGetQueryObjectiv(m_queries[readIndex][1], GL_QUERY_RESULT_AVAILABLE, &available);
+	if (!available)
+		return false;
+
+	GLuint64 beginTime = 0;
+	GLuint64 endTime = 0;
+	glGetQueryObjectui64v(m_queries[readIndex][0], GL_QUERY_RESULT, &beginTime);
+	glGetQueryObjectui64v(m_queries[readIndex][1], GL_QUERY_RESULT, &endTime);
+
+	elapsedMs = static_cast<float>(endTime - beginTime) / 1000000.0f;
+	--m_pendingCount;
+	return true;
+}
\ No newline at end of file
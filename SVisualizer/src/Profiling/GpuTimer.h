@@ -0,0 +1,26 @@
+#pragma once
+
+#include <array>
+
+// Measures gpu time between Begin/End using timestamp queries that are read
+// back a few frames later without stalling.
+class GpuTimer
+{
+public:
+	static constexpr uint32_t Latency = 3;
+public:
+	GpuTimer();
+	~GpuTimer();
+public:
+	void Begin();
+	void End();
+
+	// Retrieves the oldest finished measurement if one is available
+	bool TryGetResult(float& elapsedMs);
+private:
+	std::array<std::array<uint32_t, 2>, Latency> m_queries;
+	bool m_created;
+
+	uint32_t m_writeIndex;
+	uint32_t m_pendingCount;
+};
\ No newline at end of file
@@ -0,0 +1,90 @@
+#include "svis_pch.h"
+#include "BloomPyramid.h"
+
+#include "Rendering/ProgramBinaryCache.h"
+#include "Rendering/RenderStateCache.h"
+#include "Rendering/RenderTargetPool.h"
+
+BloomPyramid::BloomPyramid()
+	: m_levelSizes(),
+	m_levelCount(0)
+{
+	m_downsampleShader = ProgramBinaryCache::Create("Content/shaders/bloom_downsample.shader");
+	m_upsampleShader = ProgramBinaryCache::Create("Content/shaders/bloom_upsample.shader");
+
+	ELYSIUM_CORE_ASSERT(m_downsampleShader->IsCompiled(), "Bloom Downsample Shader Failed to Compile.");
+	ELYSIUM_CORE_ASSERT(m_upsampleShader->IsCompiled(), "Bloom Upsample Shader Failed to Compile.");
+}
+
+void BloomPyramid::Resize(uint32_t width, uint32_t height)
+{
+	m_result = nullptr;
+
+	m_levelCount = 0;
+	for (uint8_t i = 0; i < MaxLevels; ++i)
+	{
+		width /= 2;
+		height /= 2;
+
+		if (width < MinLevelSize || height < MinLevelSize)
+			break;
+
+		m_levelSizes[i] = Elysium::Math::iVec2(static_cast<int>(width), static_cast<int>(height));
+		++m_levelCount;
+	}
+}
+
+void BloomPyramid::Release()
+{
+	Resize(0, 0);
+}
+
+Elysium::Shared<Elysium::Texture2D> BloomPyramid::Process(const Elysium::Shared<Elysium::Texture2D>& brightTexture, const Elysium::Math::Vec2& sourceScale)
+{
+	// Last frame's result goes back to the pool, this frame likely gets it again
+	m_result = nullptr;
+
+	if (m_levelCount == 0)
+		return brightTexture;
+
+	const auto acquireLevel = [this](uint8_t level)
+	{
+		return RenderTargetPool::Acquire(m_levelSizes[level].x, m_levelSizes[level].y, { Elysium::FrameBufferTextureFormat::RGBA16F });
+	};
+
+	// Downsample Pass - progressively halve the bright color values
+	std::array<Elysium::Shared<Elysium::FrameBuffer>, MaxLevels> downFbos;
+	Elysium::Shared<Elysium::Texture2D> source = brightTexture;
+	for (uint8_t i = 0; i < m_levelCount; ++i)
+	{
+		downFbos[i] = acquireLevel(i);
+
+		// Levels are sized to the image, only the first reads from a larger target
+		const Elysium::Math::Vec2 scale = i == 0 ? sourceScale : Elysium::Math::Vec2(1.0f, 1.0f);
+		RenderStateCache::SetFloat4(m_downsampleShader, "u_Region", Elysium::Math::Vec4(1.0f, 1.0f, scale.x, scale.y));
+
+		Elysium::GraphicsCalls::ClearBuffers();
+		Elysium::RenderCommands::DrawTexture(downFbos[i], Elysium::RenderCommands::TextureDrawType::Color, 
+											 source, m_downsampleShader);
+		source = downFbos[i]->GetColorAttachment();
+	}
+
+	// Upsample Pass - walk back up the chain accumulating each level, the coarsest down level
+	// doubles as its start. Each finished level lets go of the two it was built from.
+	Elysium::Shared<Elysium::FrameBuffer> upsampled = downFbos[m_levelCount - 1];
+	for (int i = m_levelCount - 2; i >= 0; --i)
+	{
+		Elysium::Shared<Elysium::FrameBuffer> upFbo = acquireLevel(static_cast<uint8_t>(i));
+
+		Elysium::GraphicsCalls::ClearBuffers();
+		Elysium::RenderCommands::DrawTextures(upFbo, m_upsampleShader,
+											  { upsampled->GetColorAttachment(), downFbos[i]->GetColorAttachment() });
+
+		downFbos[i + 1] = nullptr;
+		downFbos[i] = nullptr;
+		upsampled = upFbo;
+	}
+
+	m_result = upsampled;
+	return m_result->GetColorAttachment();
+}
\ No newline at end of file
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "Elysium.h"
+
+// Progressive downsample/upsample bloom blur using a dual filter mip chain.
+// The levels are scratch targets from the render target pool, only the level
+// holding the result is kept until the next Process.
+class BloomPyramid
+{
+public:
+	static constexpr uint8_t MaxLevels = 6;
+	static constexpr uint32_t MinLevelSize = 8;
+public:
+	BloomPyramid();
+public:
+	void Resize(uint32_t width, uint32_t height);
+	void Release();
+
+	// The bright texture may be larger than the image, sourceScale is the portion holding it
+	Elysium::Shared<Elysium::Texture2D> Process(const Elysium::Shared<Elysium::Texture2D>& brightTexture, const Elysium::Math::Vec2& sourceScale);
+
+	inline uint8_t GetLevelCount() const { return m_levelCount; }
+private:
+	std::array<Elysium::Math::iVec2, MaxLevels> m_levelSizes;
+	uint8_t m_levelCount;
+
+	Elysium::Shared<Elysium::FrameBuffer> m_result;
+
+	Elysium::Shared<Elysium::Shader> m_downsampleShader;
+	Elysium::Shared<Elysium::Shader> m_upsampleShader;
+};
\ No newline at end of file
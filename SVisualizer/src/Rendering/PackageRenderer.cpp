@@ -0,0 +1,423 @@
+#include "svis_pch.h"
+#include "PackageRenderer.h"
+
+#include "Rendering/ProgramBinaryCache.h"
+#include "Rendering/RenderStateCache.h"
+#include "Rendering/RenderTargetPool.h"
+
+#include "Rendering/BloomPyramid.h"
+#include "Rendering/TiledRenderer.h"
+#include "Profiling/FrameProfiler.h"
+
+#include <glad/glad.h>
+
+PackageRenderer::PackageRenderer()
+	: m_width(1),
+	m_height(1),
+	m_capacityWidth(1),
+	m_capacityHeight(1),
+	m_capacityStep(0),
+	m_bloomEnabled(false),
+	m_bloomMode(BloomFilterMode::MipChain),
+	m_bloomScale(1.0f, 1.0f),
+	m_playbackTime(0.0f),
+	m_frame(0),
+	m_bufferFrame(0)
+{
+	m_shaderfbo = RenderTargetPool::Acquire(m_width, m_height, { Elysium::FrameBufferTextureFormat::RGBA8 });
+
+	m_bloomPyramid = Elysium::CreateUnique<BloomPyramid>();
+
+	m_blurShader = ProgramBinaryCache::Create("Content/shaders/blur.shader");
+	m_bloomShader = ProgramBinaryCache::Create("Content/shaders/bloom.shader");
+	m_debugShader = ProgramBinaryCache::Create("Content/shaders/debug.shader");
+
+	ELYSIUM_CORE_ASSERT(m_blurShader->IsCompiled(), "Blur Shader Failed to Compile.");
+	ELYSIUM_CORE_ASSERT(m_bloomShader->IsCompiled(), "Bloom Shader Failed to Compile.");
+	ELYSIUM_CORE_ASSERT(m_debugShader->IsCompiled(), "Debug Shader Failed to Compile.");
+}
+
+PackageRenderer::~PackageRenderer()
+{
+}
+
+void PackageRenderer::Resize(uint32_t width, uint32_t height, bool resampleBuffers)
+{
+	width = std::max(width, 1u);
+	height = std::max(height, 1u);
+
+	if (m_width == width && m_height == height)
+		return;
+
+	m_width = width;
+	m_height = height;
+
+	if (FitsCapacity())
+	{
+		// Same storage, only the bloom levels follow the image size
+		m_bloomTarget = nullptr;
+		m_bloomTexture = nullptr;
+		if (m_bloomEnabled && m_bloomMode == BloomFilterMode::MipChain)
+			m_bloomPyramid->Resize(m_width, m_height);
+	}
+	else
+	{
+		const auto roundUp = [this](uint32_t size) { return m_capacityStep > 0 ? (size + m_capacityStep - 1) / m_capacityStep * m_capacityStep : size; };
+		m_capacityWidth = roundUp(m_width);
+		m_capacityHeight = roundUp(m_height);
+
+		// Pooled targets keep their size, the old ones go back to the pool for anyone still rendering at it
+		m_shaderfbo = nullptr;
+		m_shaderfbo = RenderTargetPool::Acquire(m_capacityWidth, m_capacityHeight, { Elysium::FrameBufferTextureFormat::RGBA8 });
+		UpdateBloomTargets();
+	}
+
+	if (resampleBuffers)
+	{
+		ResampleBufferTargets();
+		return;
+	}
+
+	// Resized buffers have no meaningful history left
+	for (BufferTargets& buffer : m_buffers)
+		buffer.Targets = {};
+	AllocateBufferTargets();
+	ResetBuffers();
+}
+
+void PackageRenderer::SetCapacityStep(uint32_t step)
+{
+	m_capacityStep = step;
+}
+
+void PackageRenderer::SetBloom(bool enabled, BloomFilterMode mode)
+{
+	if (m_bloomEnabled == enabled && m_bloomMode == mode)
+		return;
+
+	m_bloomEnabled = enabled;
+	m_bloomMode = mode;
+
+	UpdateBloomTargets();
+}
+
+void PackageRenderer::Release()
+{
+	m_bloomTexture = nullptr;
+	SetBufferPasses({}, {});
+	Resize(1, 1);
+}
+
+void PackageRenderer::SetBufferPasses(const BufferPassShaders& shaders, const PassSchedule& schedule)
+{
+	if (m_bufferShaders == shaders && m_schedule == schedule)
+		return;
+
+	m_bufferShaders = shaders;
+	m_schedule = schedule;
+
+	AllocateBufferTargets();
+	ResetBuffers();
+}
+
+void PackageRenderer::SetPlaybackTime(float time)
+{
+	m_playbackTime = time;
+}
+
+void PackageRenderer::ResetBuffers()
+{
+	m_frame = 0;
+	m_bufferFrame = 0;
+
+	const float black[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+	for (BufferTargets& buffer : m_buffers)
+	{
+		buffer.Current = 0;
+		for (const Elysium::Shared<Elysium::FrameBuffer>& target : buffer.Targets)
+		{
+			if (target)
+				glClearNamedFramebufferfv(target->GetRendererID(), GL_COLOR, 0, black);
+		}
+	}
+}
+
+const Elysium::Shared<Elysium::Shader>& PackageRenderer::SelectShader(const ShaderVariants& shaders, bool bloomEnabled)
+{
+	// Only the bloom variant writes out the bright pass
+	const ShaderVariant variant = bloomEnabled ? ShaderVariant::Bloom : ShaderVariant::Standard;
+	return shaders[static_cast<size_t>(variant)];
+}
+
+void PackageRenderer::DrawBufferPasses(const Elysium::Shared<Elysium::Shader>& imageShader)
+{
+	if (!m_schedule.IsEmpty())
+	{
+		SVIS_PROFILE_GPU_SCOPE("Buffer Passes");
+
+		// Passes read what the others drew so far, feedback buffers their last frame
+		BindBuffers(nullptr);
+
+		for (uint8_t pass : m_schedule.Order)
+		{
+			BufferTargets& buffer = m_buffers[pass];
+			const Elysium::Shared<Elysium::Shader>& shader = m_bufferShaders[pass];
+			if (!shader || !buffer.Targets[0])
+				continue;
+
+			// Reads of a feedback buffer keep seeing its last frame while the other target is drawn,
+			// any other buffer is never sampled while drawn so its texture is unbound for the pass
+			const uint8_t target = m_schedule.Feedback[pass] ? 1 - buffer.Current : buffer.Current;
+			if (!m_schedule.Feedback[pass])
+				RenderStateCache::BindTexture(ShaderPackage::FirstBufferUnit + pass, Elysium::GlobalRendererBase::GetDefaultTexture());
+
+			RenderStateCache::SetFloat(shader, "u_PlaybackTime", m_playbackTime);
+			RenderStateCache::SetInt(shader, "u_Frame", m_frame);
+			RenderStateCache::SetFloat2(shader, "u_TargetScale", Elysium::Math::Vec2(1.0f, 1.0f));
+			Elysium::RenderCommands::DrawScreenShader(buffer.Targets[target], shader);
+
+			buffer.Current = target;
+			BindBuffer(pass);
+		}
+	}
+
+	m_bufferFrame = m_frame++;
+	BindBuffers(imageShader);
+}
+
+void PackageRenderer::BindBuffers(const Elysium::Shared<Elysium::Shader>& imageShader) const
+{
+	for (uint8_t pass = 0; pass < ShaderPackage::MaxBufferPasses; ++pass)
+		BindBuffer(pass);
+
+	if (imageShader)
+	{
+		RenderStateCache::SetInt(imageShader, "u_Frame", m_bufferFrame);
+		RenderStateCache::SetFloat(imageShader, "u_PlaybackTime", m_playbackTime);
+	}
+}
+
+void PackageRenderer::ResampleBufferTargets()
+{
+	for (BufferTargets& buffer : m_buffers)
+	{
+		for (Elysium::Shared<Elysium::FrameBuffer>& target : buffer.Targets)
+		{
+			if (!target)
+				continue;
+
+			const Elysium::FrameBufferSpecification& spec = target->GetSpecification();
+			Elysium::Shared<Elysium::FrameBuffer> resized = RenderTargetPool::Acquire(m_width, m_height, { Elysium::FrameBufferTextureFormat::RGBA16F });
+			glBlitNamedFramebuffer(target->GetRendererID(), resized->GetRendererID(), 0, 0, spec.Width, spec.Height,
+								   0, 0, m_width, m_height, GL_COLOR_BUFFER_BIT, GL_LINEAR);
+			target = resized;
+		}
+	}
+}
+
+void PackageRenderer::BindBuffer(uint8_t pass) const
+{
+	const BufferTargets& buffer = m_buffers[pass];
+	const uint32_t unit = ShaderPackage::FirstBufferUnit + pass;
+	if (buffer.Targets[buffer.Current])
+		RenderStateCache::BindTexture(unit, buffer.Targets[buffer.Current]->GetColorAttachment());
+	else
+		RenderStateCache::BindTexture(unit, Elysium::GlobalRendererBase::GetDefaultTexture());
+}
+
+void PackageRenderer::Render(const Elysium::Shared<Elysium::Shader>& shader, DrawPass debugPass)
+{
+	DrawPixelPass(shader);
+
+	if (m_bloomEnabled)
+		DrawPostPasses(debugPass);
+}
+
+void PackageRenderer::DrawPixelPass(const Elysium::Shared<Elysium::Shader>& shader)
+{
+	SVIS_PROFILE_GPU_SCOPE("Pixel Process");
+	RenderStateCache::SetFloat2(shader, "u_TargetScale", GetOutputScale());
+	Elysium::GraphicsCalls::ClearBuffers();
+	Elysium::RenderCommands::DrawScreenShader(GetPixelTarget(), shader);
+}
+
+void PackageRenderer::DrawPixelTiles(const Elysium::Shared<Elysium::Shader>& shader, TiledRenderer& tiledRenderer, float budgetMs)
+{
+	SVIS_PROFILE_GPU_SCOPE("Pixel Process");
+
+	RenderStateCache::SetFloat2(shader, "u_TargetScale", GetOutputScale());
+
+	const Elysium::Shared<Elysium::FrameBuffer>& target = GetPixelTarget();
+	tiledRenderer.RenderTiles(budgetMs, [&]()
+	{
+		Elysium::RenderCommands::DrawScreenShader(target, shader);
+	});
+}
+
+void PackageRenderer::DrawPostPasses(DrawPass debugPass)
+{
+	const Elysium::Math::Vec2 scale = GetOutputScale();
+	const Elysium::Math::Vec4 region(scale.x, scale.y, scale.x, scale.y);
+
+	if (m_bloomMode == BloomFilterMode::MipChain)
+	{
+		// Blur Pass - progressively downsample and upsample the bright color values
+		SVIS_PROFILE_GPU_SCOPE("Bloom Blur");
+		m_bloomTexture = m_bloomPyramid->Process(m_hdrfbo->GetColorAttachment(1), scale);
+
+		// Without any levels the bright pass itself is the blur
+		m_bloomScale = m_bloomPyramid->GetLevelCount() > 0 ? Elysium::Math::Vec2(1.0f, 1.0f) : scale;
+	}
+	else
+	{
+		SVIS_PROFILE_GPU_SCOPE("Bloom Blur");
+
+		// Ping-pong targets are scratch, only the one holding the result is kept until the next blur
+		m_bloomTarget = nullptr;
+		std::array<Elysium::Shared<Elysium::FrameBuffer>, 2> bloomFbos;
+		bloomFbos[0] = RenderTargetPool::Acquire(m_capacityWidth, m_capacityHeight, { Elysium::FrameBufferTextureFormat::RGBA16F });
+		bloomFbos[1] = RenderTargetPool::Acquire(m_capacityWidth, m_capacityHeight, { Elysium::FrameBufferTextureFormat::RGBA16F });
+		RenderStateCache::SetFloat4(m_blurShader, "u_Region", region);
+
+		// Blur Pass - blur the bright color values
+		bool horizontal = true;
+		for (uint8_t i = 0; i < BlurPasses; ++i)
+		{
+			RenderStateCache::SetInt(m_blurShader, "horizontal", horizontal);
+
+			Elysium::GraphicsCalls::ClearBuffers();
+			Elysium::RenderCommands::DrawTexture(bloomFbos[(int)horizontal], Elysium::RenderCommands::TextureDrawType::Color,
+												 i == 0 ? m_hdrfbo->GetColorAttachment(1) : bloomFbos[(int)!horizontal]->GetColorAttachment(), 
+												 m_blurShader);
+			horizontal = !horizontal;
+		}
+		m_bloomTarget = bloomFbos[(int)!horizontal];
+		m_bloomTexture = m_bloomTarget->GetColorAttachment();
+		m_bloomScale = scale;
+	}
+
+	if (debugPass == DrawPass::None)
+	{
+		// Combination Pass - tonemap hdr color and blend to shader output.
+		SVIS_PROFILE_GPU_SCOPE("Bloom Combine");
+		RenderStateCache::SetFloat4(m_bloomShader, "u_Region", region);
+		RenderStateCache::SetFloat2(m_bloomShader, "u_BloomScale", m_bloomScale);
+		Elysium::GraphicsCalls::ClearBuffers();
+		Elysium::RenderCommands::DrawTextures(m_shaderfbo, m_bloomShader,
+											  { m_hdrfbo->GetColorAttachment(), m_bloomTexture });
+	}
+	else
+	{
+		SVIS_PROFILE_GPU_SCOPE("Debug Pass");
+		Elysium::Shared<Elysium::Texture2D> debugTexToDraw = nullptr;
+		Elysium::Math::Vec2 debugScale = scale;
+		if (debugPass == DrawPass::BrightPass)
+			debugTexToDraw = m_hdrfbo->GetColorAttachment(1);
+		else if (debugPass == DrawPass::BlurPass)
+		{
+			debugTexToDraw = m_bloomTexture;
+			debugScale = m_bloomScale;
+		}
+
+		RenderStateCache::SetFloat4(m_debugShader, "u_Region", Elysium::Math::Vec4(scale.x, scale.y, debugScale.x, debugScale.y));
+		Elysium::GraphicsCalls::ClearBuffers();
+		Elysium::RenderCommands::DrawTexture(m_shaderfbo, Elysium::RenderCommands::TextureDrawType::Color, 
+											 debugTexToDraw, m_debugShader);
+	}
+}
+
+void PackageRenderer::DrawPreview()
+{
+	// Tonemap the hdr color without bloom
+	SVIS_PROFILE_GPU_SCOPE("Progressive Preview");
+	const Elysium::Math::Vec2 scale = GetOutputScale();
+	RenderStateCache::SetFloat4(m_debugShader, "u_Region", Elysium::Math::Vec4(scale.x, scale.y, scale.x, scale.y));
+	Elysium::GraphicsCalls::ClearBuffers();
+	Elysium::RenderCommands::DrawTexture(m_shaderfbo, Elysium::RenderCommands::TextureDrawType::Color,
+										 m_hdrfbo->GetColorAttachment(), m_debugShader);
+}
+
+uint32_t PackageRenderer::GetBloomMargin() const
+{
+	if (!m_bloomEnabled)
+		return 0;
+
+	if (m_bloomMode == BloomFilterMode::MipChain)
+	{
+		// Level i has texels of 2^(i+1) pixels. Its downsample reaches 2 source texels, 2^(i+1) pixels,
+		// the upsample into it 2 coarse texels plus the bilinear footprint, 3 * 2^(i+2) pixels, and the
+		// combine a level 0 texel. Summed over the levels that is 2^(levels+3) - 12 pixels, rounded up
+		// to the coarsest texel of the deepest chain so padded tiles keep their mip grids aligned.
+		const uint32_t levels = m_bloomPyramid->GetLevelCount();
+		if (levels == 0)
+			return 0;
+
+		constexpr uint32_t alignment = 1u << BloomPyramid::MaxLevels;
+		const uint32_t reach = (1u << (levels + 3)) - 12;
+		return (reach + alignment - 1) / alignment * alignment;
+	}
+
+	// Each pass per axis reaches the kernel radius in texels, sampled at texel centers. The blur
+	// targets hold the image at its own resolution, so a texel is a pixel.
+	return (BlurPasses / 2) * BlurRadius;
+}
+
+void PackageRenderer::UpdateBloomTargets()
+{
+	const bool mipChainActive = m_bloomEnabled && m_bloomMode == BloomFilterMode::MipChain;
+
+	// Without bloom the pixel pass writes straight to the output and holds no hdr target at all,
+	// the blur targets are only borrowed from the pool while the post passes run
+	m_bloomTarget = nullptr;
+	m_bloomTexture = nullptr;
+	m_hdrfbo = nullptr;
+	if (m_bloomEnabled)
+	{
+		m_hdrfbo = RenderTargetPool::Acquire(m_capacityWidth, m_capacityHeight, { 
+			Elysium::FrameBufferTextureFormat::RGBA16F,
+			Elysium::FrameBufferTextureFormat::RGBA16F 
+		});
+	}
+
+	if (mipChainActive)
+		m_bloomPyramid->Resize(m_width, m_height);
+	else
+		m_bloomPyramid->Release();
+}
+
+bool PackageRenderer::FitsCapacity() const
+{
+	if (m_capacityStep == 0)
+		return m_capacityWidth == m_width && m_capacityHeight == m_height;
+
+	// Shrinking by more than a step gives the memory back instead
+	const auto fits = [this](uint32_t size, uint32_t capacity) { return size <= capacity && capacity - size < m_capacityStep * 2; };
+	return fits(m_width, m_capacityWidth) && fits(m_height, m_capacityHeight);
+}
+
+void PackageRenderer::AllocateBufferTargets()
+{
+	const auto acquireTarget = [this]()
+	{
+		return RenderTargetPool::Acquire(m_width, m_height, { Elysium::FrameBufferTextureFormat::RGBA16F });
+	};
+
+	// Buffers the image doesn't depend on are never drawn and keep no targets, only feedback
+	// buffers need a second one
+	for (uint8_t pass = 0; pass < ShaderPackage::MaxBufferPasses; ++pass)
+	{
+		BufferTargets& buffer = m_buffers[pass];
+		const bool scheduled = m_schedule.IsScheduled(pass) && m_bufferShaders[pass] != nullptr;
+		const bool feedback = scheduled && m_schedule.Feedback[pass];
+
+		if (scheduled && !buffer.Targets[0])
+			buffer.Targets[0] = acquireTarget();
+		else if (!scheduled)
+			buffer.Targets[0] = nullptr;
+
+		if (feedback && !buffer.Targets[1])
+			buffer.Targets[1] = acquireTarget();
+		else if (!feedback)
+			buffer.Targets[1] = nullptr;
+	}
+}
\ No newline at end of file
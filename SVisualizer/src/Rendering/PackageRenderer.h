@@ -0,0 +1,132 @@
+#pragma once
+
+#include "Elysium.h"
+
+#include "ShaderPackage.h"
+
+class BloomPyramid;
+class TiledRenderer;
+
+// Owns the render targets and post shaders for drawing a shader package
+// through the buffer, pixel, bloom and tonemapping passes at a given resolution.
+// Targets come from the render target pool, the output and whatever has to survive
+// the frame is held, blur targets are only borrowed while the post passes run.
+// With a capacity step the full resolution targets are over-allocated to the next
+// step and the image drawn into their lower left corner, so small size changes
+// keep the same storage. Buffer targets and bloom levels always match the image.
+// The engine's framebuffer bind resets the viewport, so the passes confine themselves:
+// u_TargetScale and u_Region.xy scale the quad onto the image portion of the target,
+// u_Region.zw scales the uvs onto the image portion of the texture sampled.
+class PackageRenderer
+{
+public:
+	enum class DrawPass : uint8_t
+	{
+		None,
+		BrightPass,
+		BlurPass,
+
+		Count
+	};
+public:
+	// Gaussian blur passes, alternating horizontal and vertical, and the texels blur.shader reaches out
+	static constexpr uint8_t BlurPasses = 10;
+	static constexpr uint32_t BlurRadius = 4;
+public:
+	PackageRenderer();
+	~PackageRenderer();
+public:
+	// With resampleBuffers the buffer contents are scaled into the resized targets instead of cleared,
+	// for resolution changes that show the same image such as a lower preview scale
+	void Resize(uint32_t width, uint32_t height, bool resampleBuffers = false);
+	// Rounds target capacity up to multiples of the step, 0 allocates the exact size
+	void SetCapacityStep(uint32_t step);
+	void SetBloom(bool enabled, BloomFilterMode mode);
+	void Release();
+
+	// Swaps in the package's buffer passes, any change clears their history
+	void SetBufferPasses(const BufferPassShaders& shaders, const PassSchedule& schedule);
+	void SetPlaybackTime(float time);
+	// Restarts feedback buffers from black and the frame counter from zero
+	void ResetBuffers();
+
+	static const Elysium::Shared<Elysium::Shader>& SelectShader(const ShaderVariants& shaders, bool bloomEnabled);
+
+	void Render(const Elysium::Shared<Elysium::Shader>& shader, DrawPass debugPass = DrawPass::None);
+
+	// Draws the scheduled buffer passes and binds their outputs for the image pass
+	void DrawBufferPasses(const Elysium::Shared<Elysium::Shader>& imageShader);
+	// Binds the buffer outputs of the last DrawBufferPasses, their frame count and the playback time for the image pass.
+	// The units are shared by every renderer, so anything drawing the image binds its own first.
+	void BindBuffers(const Elysium::Shared<Elysium::Shader>& imageShader) const;
+	void DrawPixelPass(const Elysium::Shared<Elysium::Shader>& shader);
+	void DrawPixelTiles(const Elysium::Shared<Elysium::Shader>& shader, TiledRenderer& tiledRenderer, float budgetMs);
+	void DrawPostPasses(DrawPass debugPass);
+	void DrawPreview();
+
+	inline uint32_t GetWidth() const { return m_width; }
+	inline uint32_t GetHeight() const { return m_height; }
+	inline uint32_t GetCapacityWidth() const { return m_capacityWidth; }
+	inline uint32_t GetCapacityHeight() const { return m_capacityHeight; }
+	// Portion of the output, hdr and gaussian bloom targets holding the image
+	inline Elysium::Math::Vec2 GetOutputScale() const { return Elysium::Math::Vec2(m_width / static_cast<float>(m_capacityWidth), m_height / static_cast<float>(m_capacityHeight)); }
+	inline bool IsBloomEnabled() const { return m_bloomEnabled; }
+
+	// Widest reach of the active bloom filter in pixels at the current size, tiles need this much
+	// overlap to blend seamlessly
+	uint32_t GetBloomMargin() const;
+
+	inline const Elysium::Shared<Elysium::FrameBuffer>& GetOutput() const { return m_shaderfbo; }
+	inline const Elysium::Shared<Elysium::FrameBuffer>& GetHdrOutput() const { return m_hdrfbo; }
+	inline const Elysium::Shared<Elysium::Texture2D>& GetBloomOutput() const { return m_bloomTexture; }
+	inline const Elysium::Shared<Elysium::FrameBuffer>& GetPixelTarget() const { return m_bloomEnabled ? m_hdrfbo : m_shaderfbo; }
+private:
+	void UpdateBloomTargets();
+	// Whether the targets can keep their capacity for the current size
+	bool FitsCapacity() const;
+	void AllocateBufferTargets();
+	// Replaces the buffer targets with ones at the current size holding their scaled contents
+	void ResampleBufferTargets();
+	void BindBuffer(uint8_t pass) const;
+private:
+	struct BufferTargets
+	{
+	public:
+		// Feedback buffers draw into the second target while passes read the first, then swap
+		std::array<Elysium::Shared<Elysium::FrameBuffer>, 2> Targets;
+		uint8_t Current = 0;
+	};
+private:
+	uint32_t m_width;
+	uint32_t m_height;
+	uint32_t m_capacityWidth;
+	uint32_t m_capacityHeight;
+	uint32_t m_capacityStep;
+
+	bool m_bloomEnabled;
+	BloomFilterMode m_bloomMode;
+
+	// Only held while bloom is enabled
+	Elysium::Shared<Elysium::FrameBuffer> m_hdrfbo;
+	// Gaussian blur result, kept for the debug view and hdr export
+	Elysium::Shared<Elysium::FrameBuffer> m_bloomTarget;
+	Elysium::Math::Vec2 m_bloomScale;
+	Elysium::Shared<Elysium::FrameBuffer> m_shaderfbo;
+
+	Elysium::Unique<BloomPyramid> m_bloomPyramid;
+
+	BufferPassShaders m_bufferShaders;
+	PassSchedule m_schedule;
+	std::array<BufferTargets, ShaderPackage::MaxBufferPasses> m_buffers;
+	float m_playbackTime;
+	int m_frame;
+	// Frame the buffers currently hold
+	int m_bufferFrame;
+
+	// Blurred bright pass of the last post pass
+	Elysium::Shared<Elysium::Texture2D> m_bloomTexture;
+
+	Elysium::Shared<Elysium::Shader> m_blurShader;
+	Elysium::Shared<Elysium::Shader> m_bloomShader;
+	Elysium::Shared<Elysium::Shader> m_debugShader;
+};
\ No newline at end of file
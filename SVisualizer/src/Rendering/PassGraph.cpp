@@ -0,0 +1,94 @@
+#include "svis_pch.h"
+#include "PassGraph.h"
+
+static const char* const s_bufferDefines[PassGraph::MaxBufferPasses] = { "BUFFER_A", "BUFFER_B", "BUFFER_C", "BUFFER_D" };
+static const char* const s_bufferNames[PassGraph::MaxBufferPasses] = { "Buffer A", "Buffer B", "Buffer C", "Buffer D" };
+
+bool PassSchedule::IsScheduled(uint8_t pass) const
+{
+	return std::find(Order.begin(), Order.end(), pass) != Order.end();
+}
+
+bool PassSchedule::HasFeedback() const
+{
+	return std::find(Feedback.begin(), Feedback.end(), true) != Feedback.end();
+}
+
+PassSchedule PassGraph::Resolve(const std::string& imageCode, const std::array<std::string, MaxBufferPasses>& bufferCodes)
+{
+	// Which existing buffers every pass samples, the image pass last
+	constexpr uint8_t imagePass = MaxBufferPasses;
+	std::array<std::array<bool, MaxBufferPasses>, MaxBufferPasses + 1> reads = {};
+	for (uint8_t pass = 0; pass <= imagePass; ++pass)
+	{
+		const std::string& code = pass == imagePass ? imageCode : bufferCodes[pass];
+		for (uint8_t buffer = 0; buffer < MaxBufferPasses; ++buffer)
+			reads[pass][buffer] = !code.empty() && !bufferCodes[buffer].empty() && ContainsIdentifier(code, s_bufferDefines[buffer]);
+	}
+
+	PassSchedule schedule;
+	for (uint8_t buffer = 0; buffer < MaxBufferPasses; ++buffer)
+		schedule.Feedback[buffer] = reads[buffer][buffer];
+
+	// Depth first from the image, a pass is placed once everything it reads has been. Reaching a pass
+	// that is still being visited closes a cycle, so that read gets the previous frame instead.
+	enum class VisitState : uint8_t { Unvisited, Visiting, Placed };
+	std::array<VisitState, MaxBufferPasses> states = {};
+
+	const std::function<void(uint8_t)> visit = [&](uint8_t pass)
+	{
+		states[pass] = VisitState::Visiting;
+		for (uint8_t buffer = 0; buffer < MaxBufferPasses; ++buffer)
+		{
+			if (!reads[pass][buffer] || buffer == pass)
+				continue;
+
+			if (states[buffer] == VisitState::Unvisited)
+				visit(buffer);
+			else if (states[buffer] == VisitState::Visiting)
+				schedule.Feedback[buffer] = true;
+		}
+		states[pass] = VisitState::Placed;
+		schedule.Order.push_back(pass);
+	};
+
+	for (uint8_t buffer = 0; buffer < MaxBufferPasses; ++buffer)
+	{
+		if (reads[imagePass][buffer] && states[buffer] == VisitState::Unvisited)
+			visit(buffer);
+	}
+
+	// Unscheduled buffers are never drawn, so they have no history to keep
+	for (uint8_t buffer = 0; buffer < MaxBufferPasses; ++buffer)
+		schedule.Feedback[buffer] = schedule.Feedback[buffer] && states[buffer] == VisitState::Placed;
+
+	return schedule;
+}
+
+const char* PassGraph::GetBufferDefine(uint8_t pass)
+{
+	return pass < MaxBufferPasses ? s_bufferDefines[pass] : "";
+}
+
+const char* PassGraph::GetBufferName(uint8_t pass)
+{
+	return pass < MaxBufferPasses ? s_bufferNames[pass] : "Image";
+}
+
+bool PassGraph::ContainsIdentifier(const std::string& code, const std::string& identifier)
+{
+	const auto isIdentifierChar = [](char c) { return std::isalnum(static_cast<unsigned char>(c)) || c == '_'; };
+
+	size_t pos = code.find(identifier);
+	while (pos != std::string::npos)
+	{
+		const size_t end = pos + identifier.length();
+		const bool startBoundary = pos == 0 || !isIdentifierChar(code[pos - 1]);
+		const bool endBoundary = end == code.length() || !isIdentifierChar(code[end]);
+		if (startBoundary && endBoundary)
+			return true;
+
+		pos = code.find(identifier, end);
+	}
+	return false;
+}
\ No newline at end of file
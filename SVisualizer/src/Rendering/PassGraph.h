@@ -0,0 +1,45 @@
+#pragma once
+
+#include <string>
+#include <array>
+#include <vector>
+
+struct PassSchedule;
+
+// Resolves the order of a package's buffer passes from which buffers each pass samples.
+// Passes are scheduled after the buffers they read, the image pass last. Where passes read each
+// other in a cycle, the read going against the order sees that buffer's previous frame.
+class PassGraph
+{
+public:
+	static constexpr uint8_t MaxBufferPasses = 4;
+public:
+	static PassSchedule Resolve(const std::string& imageCode, const std::array<std::string, MaxBufferPasses>& bufferCodes);
+
+	// Shader define sampling a buffer's output ("BUFFER_A")
+	static const char* GetBufferDefine(uint8_t pass);
+	// Display name ("Buffer A")
+	static const char* GetBufferName(uint8_t pass);
+
+	// Whether the code mentions the identifier as a whole word
+	static bool ContainsIdentifier(const std::string& code, const std::string& identifier);
+};
+
+// Buffer passes to draw ahead of a package's image pass
+struct PassSchedule
+{
+public:
+	// Passes in the order they are drawn, passes the image doesn't depend on are left out
+	std::vector<uint8_t> Order;
+
+	// Buffers sampled before they are drawn within a frame, by themselves or by a pass running
+	// ahead of them. These see the previous frame and keep a second target to draw into.
+	std::array<bool, PassGraph::MaxBufferPasses> Feedback = {};
+public:
+	inline bool IsEmpty() const { return Order.empty(); }
+	bool IsScheduled(uint8_t pass) const;
+	bool HasFeedback() const;
+
+	inline bool operator==(const PassSchedule& other) const { return Order == other.Order && Feedback == other.Feedback; }
+	inline bool operator!=(const PassSchedule& other) const { return !(*this == other); }
+};
\ No newline at end of file
@@ -0,0 +1,415 @@
+#include "svis_pch.h"
+#include "ProgramBinaryCache.h"
+
+#include "Elysium/Utils/FileUtils.h"
+#include "Elysium/Factories/ShaderFactory.h"
+
+#include <glad/glad.h>
+
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+// Bump whenever the entry layout or the way keys are built changes
+static constexpr uint32_t CacheMagic = 0x42505653; // "SVPB"
+static constexpr uint32_t CacheVersion = 1;
+
+// Binaries are loaded into a program created from this, the engine has no way to wrap a bare program object
+static const char* PlaceholderCode =
+	"#shader vertex\n"
+	"#version 420\n"
+	"void main() { gl_Position = vec4(0.0); }\n"
+	"#shader fragment\n"
+	"#version 420\n"
+	"layout(location = 0) out vec4 Color;\n"
+	"void main() { Color = vec4(0.0); }\n";
+
+struct CacheEntryHeader
+{
+	uint32_t Magic;
+	uint32_t Version;
+	uint64_t Key;
+	uint32_t BinaryFormat;
+	uint32_t Length;
+};
+
+struct ProgramBinaryCacheData
+{
+	std::mutex Mutex;
+
+	bool Enabled = false;
+	std::string Directory;
+	std::string DriverIdentity;
+	uint64_t MaxSize = ProgramBinaryCache::DefaultMaxSize;
+
+	ProgramBinaryCache::Statistics Stats;
+};
+
+static ProgramBinaryCacheData s_data;
+
+static uint64_t HashString(uint64_t hash, const std::string& value)
+{
+	// FNV-1a
+	for (char c : value)
+	{
+		hash ^= static_cast<uint8_t>(c);
+		hash *= 1099511628211ull;
+	}
+	return hash;
+}
+
+static uint64_t ComputeKey(const std::string& code)
+{
+	uint64_t hash = 14695981039346656037ull;
+	hash = HashString(hash, s_data.DriverIdentity);
+	hash = HashString(hash, code);
+	return hash;
+}
+
+static fs::path GetEntryPath(uint64_t key)
+{
+	char filename[24];
+	std::snprintf(filename, sizeof(filename), "%016llx.bin", static_cast<unsigned long long>(key));
+	return fs::path(s_data.Directory) / filename;
+}
+
+static const char* GetGLString(GLenum name)
+{
+	const GLubyte* value = glGetString(name);
+	return value != nullptr ? reinterpret_cast<const char*>(value) : "";
+}
+
+// Has to be called with the mutex held
+static void ScanEntries()
+{
+	s_data.Stats.EntryCount = 0;
+	s_data.Stats.TotalBytes = 0;
+
+	std::error_code error;
+	for (const fs::directory_entry& entry : fs::directory_iterator(s_data.Directory, error))
+	{
+		if (entry.path().extension() != ".bin")
+			continue;
+
+		++s_data.Stats.EntryCount;
+		s_data.Stats.TotalBytes += entry.file_size(error);
+	}
+}
+
+// Has to be called with the mutex held
+static void EvictEntries()
+{
+	if (s_data.Stats.TotalBytes <= s_data.MaxSize)
+		return;
+
+	struct EntryInfo
+	{
+		fs::path Path;
+		fs::file_time_type LastUsed;
+		uint64_t Size;
+	};
+
+	std::error_code error;
+	std::vector<EntryInfo> entries;
+	for (const fs::directory_entry& entry : fs::directory_iterator(s_data.Directory, error))
+	{
+		if (entry.path().extension() == ".bin")
+			entries.push_back({ entry.path(), entry.last_write_time(error), entry.file_size(error) });
+	}
+
+	// Hits touch their entry, so the oldest write time is the least recently used one
+	std::sort(entries.begin(), entries.end(), [](const EntryInfo& a, const EntryInfo& b) { return a.LastUsed < b.LastUsed; });
+
+	for (const EntryInfo& entry : entries)
+	{
+		if (s_data.Stats.TotalBytes <= s_data.MaxSize)
+			break;
+
+		if (fs::remove(entry.Path, error))
+		{
+			s_data.Stats.TotalBytes -= std::min(entry.Size, s_data.Stats.TotalBytes);
+			--s_data.Stats.EntryCount;
+			++s_data.Stats.Evictions;
+		}
+	}
+}
+
+// Has to be called with the mutex held
+static void RemoveEntry(const fs::path& path)
+{
+	std::error_code error;
+	const uint64_t size = fs::file_size(path, error);
+	if (!error && fs::remove(path, error))
+	{
+		s_data.Stats.TotalBytes -= std::min(size, s_data.Stats.TotalBytes);
+		--s_data.Stats.EntryCount;
+	}
+}
+
+static bool LoadEntry(uint64_t key, uint32_t& binaryFormat, std::vector<char>& binary)
+{
+	std::ifstream stream(GetEntryPath(key), std::ios::binary);
+	if (!stream.good())
+		return false;
+
+	CacheEntryHeader header;
+	stream.read(reinterpret_cast<char*>(&header), sizeof(header));
+	if (!stream || header.Magic != CacheMagic || header.Version != CacheVersion || header.Key != key || header.Length == 0)
+		return false;
+
+	binary.resize(header.Length);
+	stream.read(binary.data(), header.Length);
+	if (!stream)
+		return false;
+
+	binaryFormat = header.BinaryFormat;
+	return true;
+}
+
+// The engine links its programs without the retrievable hint, which lets drivers return an incomplete
+// binary or none at all. The hint applies from the next link, so the program is linked again with it.
+static bool CanRelink(uint32_t programID)
+{
+	GLint attachedShaders = 0;
+	glGetProgramiv(programID, GL_ATTACHED_SHADERS, &attachedShaders);
+	return attachedShaders > 0;
+}
+
+static bool MakeRetrievable(uint32_t programID)
+{
+	glProgramParameteri(programID, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+	glLinkProgram(programID);
+
+	GLint linked = GL_FALSE;
+	glGetProgramiv(programID, GL_LINK_STATUS, &linked);
+	return linked == GL_TRUE;
+}
+
+static void StoreEntry(uint64_t key, uint32_t programID)
+{
+	GLint length = 0;
+	glGetProgramiv(programID, GL_PROGRAM_BINARY_LENGTH, &length);
+	if (length <= 0)
+		return;
+
+	std::vector<char> binary(length);
+	GLenum binaryFormat = 0;
+	glGetProgramBinary(programID, length, &length, &binaryFormat, binary.data());
+	if (length <= 0)
+		return;
+
+	const CacheEntryHeader header = { CacheMagic, CacheVersion, key, binaryFormat, static_cast<uint32_t>(length) };
+
+	std::lock_guard<std::mutex> lock(s_data.Mutex);
+
+	// Write next to the entry and rename, a crash mid write must not leave a truncated entry behind
+	const fs::path entryPath = GetEntryPath(key);
+	fs::path tempPath = entryPath;
+	tempPath += ".tmp";
+	{
+		std::ofstream stream(tempPath, std::ios::binary | std::ios::trunc);
+		stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		stream.write(binary.data(), length);
+		if (!stream.good())
+		{
+			ELYSIUM_WARN("Failed to Write Program Binary Cache Entry.");
+			return;
+		}
+	}
+
+	std::error_code error;
+	if (fs::exists(entryPath, error))
+		RemoveEntry(entryPath);
+
+	fs::rename(tempPath, entryPath, error);
+	if (error)
+	{
+		fs::remove(tempPath, error);
+		return;
+	}
+
+	++s_data.Stats.Stores;
+	++s_data.Stats.EntryCount;
+	s_data.Stats.TotalBytes += sizeof(header) + length;
+
+	EvictEntries();
+}
+
+void ProgramBinaryCache::Init(const std::string& directory, uint64_t maxSize)
+{
+	std::lock_guard<std::mutex> lock(s_data.Mutex);
+
+	s_data.Enabled = false;
+	s_data.Directory = directory;
+	s_data.MaxSize = maxSize;
+	s_data.Stats = Statistics();
+
+	GLint formatCount = 0;
+	glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+	if (formatCount <= 0)
+	{
+		ELYSIUM_WARN("Driver Supports no Program Binary Formats, Program Cache Disabled.");
+		return;
+	}
+
+	std::error_code error;
+	fs::create_directories(s_data.Directory, error);
+	if (error)
+	{
+		ELYSIUM_WARN("Failed to Create Program Cache Directory, Program Cache Disabled.");
+		return;
+	}
+
+	std::stringstream identity;
+	identity << GetGLString(GL_VENDOR) << '\n' << GetGLString(GL_RENDERER) << '\n' << GetGLString(GL_VERSION) << '\n' << CacheVersion;
+	s_data.DriverIdentity = identity.str();
+	s_data.Enabled = true;
+
+	ScanEntries();
+	EvictEntries();
+}
+
+void ProgramBinaryCache::Shutdown()
+{
+	std::lock_guard<std::mutex> lock(s_data.Mutex);
+	s_data.Enabled = false;
+}
+
+Elysium::Shared<Elysium::Shader> ProgramBinaryCache::CreateFromCode(const std::string& code, std::string* error)
+{
+	uint64_t key = 0;
+	{
+		std::lock_guard<std::mutex> lock(s_data.Mutex);
+		if (!s_data.Enabled)
+			return Elysium::ShaderFactory::CreateFromCode(code, error);
+
+		key = ComputeKey(code);
+	}
+
+	uint32_t binaryFormat = 0;
+	std::vector<char> binary;
+	bool loaded = false;
+	{
+		std::lock_guard<std::mutex> lock(s_data.Mutex);
+		loaded = LoadEntry(key, binaryFormat, binary);
+	}
+
+	if (loaded)
+	{
+		Elysium::Shared<Elysium::Shader> shader = Elysium::ShaderFactory::CreateFromCode(PlaceholderCode);
+		if (shader != nullptr)
+		{
+			const GLuint programID = shader->GetRendererID();
+			glProgramBinary(programID, binaryFormat, binary.data(), static_cast<GLsizei>(binary.size()));
+
+			GLint linked = GL_FALSE;
+			glGetProgramiv(programID, GL_LINK_STATUS, &linked);
+
+			std::lock_guard<std::mutex> lock(s_data.Mutex);
+			const fs::path entryPath = GetEntryPath(key);
+			if (linked == GL_TRUE)
+			{
+				// Touch the entry so eviction sees it as recently used
+				std::error_code fsError;
+				fs::last_write_time(entryPath, fs::file_time_type::clock::now(), fsError);
+
+				++s_data.Stats.Hits;
+				return shader;
+			}
+
+			++s_data.Stats.Rejected;
+			RemoveEntry(entryPath);
+		}
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(s_data.Mutex);
+		++s_data.Stats.Misses;
+	}
+
+	Elysium::Shared<Elysium::Shader> shader = Elysium::ShaderFactory::CreateFromCode(code, error);
+	if (shader == nullptr)
+		return shader;
+
+	// Programs whose shaders are already detached cannot take the hint and stay out of the cache
+	if (!CanRelink(shader->GetRendererID()))
+		return shader;
+
+	if (MakeRetrievable(shader->GetRendererID()))
+		StoreEntry(key, shader->GetRendererID());
+	else
+	{
+		// A program that could not be linked again is rebuilt and left out of the cache
+		ELYSIUM_WARN("Failed to Link Retrievable Program, Program Not Cached.");
+		shader = Elysium::ShaderFactory::CreateFromCode(code, error);
+	}
+	return shader;
+}
+
+Elysium::Shared<Elysium::Shader> ProgramBinaryCache::Create(const std::string& filepath)
+{
+	const std::string solvedFilepath = Elysium::FileUtils::GetAssetPath_Str(filepath);
+	std::ifstream stream(solvedFilepath);
+	if (!stream.good() || !IsEnabled())
+		return Elysium::ShaderFactory::Create(filepath);
+
+	const std::string code((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+
+	std::string error;
+	Elysium::Shared<Elysium::Shader> shader = CreateFromCode(code, &error);
+	if (shader == nullptr)
+	{
+		ELYSIUM_ERROR(error.c_str());
+		return Elysium::ShaderFactory::Create(filepath);
+	}
+	return shader;
+}
+
+void ProgramBinaryCache::Clear()
+{
+	std::lock_guard<std::mutex> lock(s_data.Mutex);
+	if (s_data.Directory.empty())
+		return;
+
+	std::error_code error;
+	for (const fs::directory_entry& entry : fs::directory_iterator(s_data.Directory, error))
+	{
+		if (entry.path().extension() == ".bin" || entry.path().extension() == ".tmp")
+			fs::remove(entry.path(), error);
+	}
+
+	s_data.Stats.EntryCount = 0;
+	s_data.Stats.TotalBytes = 0;
+}
+
+uint64_t ProgramBinaryCache::GetMaxSize()
+{
+	std::lock_guard<std::mutex> lock(s_data.Mutex);
+	return s_data.MaxSize;
+}
+
+void ProgramBinaryCache::SetMaxSize(uint64_t maxSize)
+{
+	std::lock_guard<std::mutex> lock(s_data.Mutex);
+	s_data.MaxSize = maxSize;
+
+	if (s_data.Enabled)
+		EvictEntries();
+}
+
+bool ProgramBinaryCache::IsEnabled()
+{
+	std::lock_guard<std::mutex> lock(s_data.Mutex);
+	return s_data.Enabled;
+}
+
+const std::string& ProgramBinaryCache::GetDirectory()
+{
+	return s_data.Directory;
+}
+
+ProgramBinaryCache::Statistics ProgramBinaryCache::GetStatistics()
+{
+	std::lock_guard<std::mutex> lock(s_data.Mutex);
+	return s_data.Stats;
+}
\ No newline at end of file
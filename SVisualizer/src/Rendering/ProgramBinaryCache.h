@@ -0,0 +1,45 @@
+#pragma once
+
+#include "Elysium.h"
+
+#include <string>
+
+// Persists linked program binaries on disk so that unchanged shaders skip the driver compile on the next run.
+// Entries are keyed by a hash of the final shader source and the driver identity, so a driver update
+// simply misses instead of loading a binary the driver no longer accepts.
+class ProgramBinaryCache
+{
+public:
+	static constexpr uint64_t DefaultMaxSize = 256ull * 1024ull * 1024ull;
+public:
+	struct Statistics
+	{
+	public:
+		uint32_t Hits = 0;
+		uint32_t Misses = 0;
+		uint32_t Stores = 0;
+		// Binaries the driver refused to load, usually after a driver update
+		uint32_t Rejected = 0;
+		uint32_t Evictions = 0;
+
+		uint32_t EntryCount = 0;
+		uint64_t TotalBytes = 0;
+	};
+public:
+	// Has to be called on the thread owning the main context, the driver identity is queried here
+	static void Init(const std::string& directory, uint64_t maxSize = DefaultMaxSize);
+	static void Shutdown();
+
+	// Drop in replacements for the ShaderFactory calls that go through the cache
+	static Elysium::Shared<Elysium::Shader> CreateFromCode(const std::string& code, std::string* error = nullptr);
+	static Elysium::Shared<Elysium::Shader> Create(const std::string& filepath);
+
+	static void Clear();
+
+	static uint64_t GetMaxSize();
+	static void SetMaxSize(uint64_t maxSize);
+
+	static bool IsEnabled();
+	static const std::string& GetDirectory();
+	static Statistics GetStatistics();
+};
\ No newline at end of file
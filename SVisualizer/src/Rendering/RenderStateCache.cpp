@@ -0,0 +1,200 @@
+#include "svis_pch.h"
+#include "RenderStateCache.h"
+
+#include "Textures/SlotTexture.h"
+
+#include <glad/glad.h>
+
+#include <cstring>
+
+struct TrackedUniform
+{
+	GLint Location = -1;
+	bool HasValue = false;
+	std::array<uint32_t, 4> Bits = {};
+};
+
+struct TrackedProgram
+{
+	// Program names are recycled once deleted, the owner tells a reused name apart
+	std::weak_ptr<Elysium::Shader> Owner;
+	std::unordered_map<std::string, TrackedUniform> Uniforms;
+};
+
+struct TrackedUnit
+{
+	// Engine and slot textures alike, only compared by identity
+	std::weak_ptr<const void> Texture;
+	uint32_t RendererID = 0;
+};
+
+struct RenderStateCacheData
+{
+	std::unordered_map<uint32_t, TrackedProgram> Programs;
+	std::vector<TrackedUnit> Units;
+
+	std::array<RenderStateCache::Counters, (size_t)RenderStateCache::StateType::Count> FrameCounters;
+	std::array<RenderStateCache::Counters, (size_t)RenderStateCache::StateType::Count> LastFrameCounters;
+	std::array<RenderStateCache::Counters, (size_t)RenderStateCache::StateType::Count> TotalCounters;
+};
+
+static RenderStateCacheData s_data;
+
+static void CountCall(RenderStateCache::StateType type, bool issued)
+{
+	RenderStateCache::Counters& frame = s_data.FrameCounters[(size_t)type];
+	RenderStateCache::Counters& total = s_data.TotalCounters[(size_t)type];
+	if (issued)
+	{
+		++frame.Issued;
+		++total.Issued;
+	}
+	else
+	{
+		++frame.Skipped;
+		++total.Skipped;
+	}
+}
+
+static TrackedUniform& FindUniform(const Elysium::Shared<Elysium::Shader>& shader, const std::string& name)
+{
+	const uint32_t programID = shader->GetRendererID();
+
+	TrackedProgram& program = s_data.Programs[programID];
+	if (program.Owner.lock() != shader)
+	{
+		program.Owner = shader;
+		program.Uniforms.clear();
+	}
+
+	auto found = program.Uniforms.find(name);
+	if (found == program.Uniforms.end())
+	{
+		TrackedUniform uniform;
+		uniform.Location = glGetUniformLocation(programID, name.c_str());
+		found = program.Uniforms.emplace(name, uniform).first;
+	}
+	return found->second;
+}
+
+// Returns true when the value differs from the one the program already holds
+static bool UpdateUniform(TrackedUniform& uniform, const void* value, size_t size)
+{
+	std::array<uint32_t, 4> bits = {};
+	std::memcpy(bits.data(), value, size);
+
+	// Uniforms the linker stripped take no call at all
+	const bool changed = uniform.Location != -1 && (!uniform.HasValue || uniform.Bits != bits);
+	CountCall(RenderStateCache::StateType::Uniform, changed);
+	if (!changed)
+		return false;
+
+	uniform.Bits = bits;
+	uniform.HasValue = true;
+	return true;
+}
+
+// Returns true when the unit has to be rebound
+template<typename T>
+static bool UpdateUnit(uint32_t unit, const Elysium::Shared<T>& texture)
+{
+	if (unit >= s_data.Units.size())
+		s_data.Units.resize(unit + 1);
+
+	TrackedUnit& tracked = s_data.Units[unit];
+	const uint32_t rendererID = texture->GetRendererID();
+	const bool changed = tracked.RendererID != rendererID || tracked.Texture.lock().get() != static_cast<const void*>(texture.get());
+	CountCall(RenderStateCache::StateType::Texture, changed);
+	if (!changed)
+		return false;
+
+	tracked.Texture = std::static_pointer_cast<const void>(texture);
+	tracked.RendererID = rendererID;
+	return true;
+}
+
+void RenderStateCache::BindTexture(uint32_t unit, const Elysium::Shared<Elysium::Texture2D>& texture)
+{
+	if (texture != nullptr && UpdateUnit(unit, texture))
+		texture->Bind(unit);
+}
+
+void RenderStateCache::BindTexture(uint32_t unit, const Elysium::Shared<SlotTexture>& texture)
+{
+	if (texture != nullptr && UpdateUnit(unit, texture))
+		texture->Bind(unit);
+}
+
+void RenderStateCache::SetInt(const Elysium::Shared<Elysium::Shader>& shader, const std::string& name, int value)
+{
+	TrackedUniform& uniform = FindUniform(shader, name);
+	if (UpdateUniform(uniform, &value, sizeof(value)))
+		glProgramUniform1i(shader->GetRendererID(), uniform.Location, value);
+}
+
+void RenderStateCache::SetFloat(const Elysium::Shared<Elysium::Shader>& shader, const std::string& name, float value)
+{
+	TrackedUniform& uniform = FindUniform(shader, name);
+	if (UpdateUniform(uniform, &value, sizeof(value)))
+		glProgramUniform1f(shader->GetRendererID(), uniform.Location, value);
+}
+
+bool RenderStateCache::GetFloat(const Elysium::Shared<Elysium::Shader>& shader, const std::string& name, float& value)
+{
+	const TrackedUniform& uniform = FindUniform(shader, name);
+	if (!uniform.HasValue)
+		return false;
+
+	std::memcpy(&value, uniform.Bits.data(), sizeof(value));
+	return true;
+}
+
+void RenderStateCache::SetFloat2(const Elysium::Shared<Elysium::Shader>& shader, const std::string& name, const Elysium::Math::Vec2& value)
+{
+	const float values[2] = { value.x, value.y };
+
+	TrackedUniform& uniform = FindUniform(shader, name);
+	if (UpdateUniform(uniform, values, sizeof(values)))
+		glProgramUniform2fv(shader->GetRendererID(), uniform.Location, 1, values);
+}
+
+void RenderStateCache::SetFloat4(const Elysium::Shared<Elysium::Shader>& shader, const std::string& name, const Elysium::Math::Vec4& value)
+{
+	const float values[4] = { value.x, value.y, value.z, value.w };
+
+	TrackedUniform& uniform = FindUniform(shader, name);
+	if (UpdateUniform(uniform, values, sizeof(values)))
+		glProgramUniform4fv(shader->GetRendererID(), uniform.Location, 1, values);
+}
+
+void RenderStateCache::EndFrame()
+{
+	s_data.LastFrameCounters = s_data.FrameCounters;
+	s_data.FrameCounters.fill(Counters());
+
+	// Drop programs that have since been deleted
+	for (auto it = s_data.Programs.begin(); it != s_data.Programs.end();)
+	{
+		if (it->second.Owner.expired())
+			it = s_data.Programs.erase(it);
+		else
+			++it;
+	}
+}
+
+RenderStateCache::Counters RenderStateCache::GetFrameCounters(StateType type)
+{
+	return s_data.LastFrameCounters[(size_t)type];
+}
+
+RenderStateCache::Counters RenderStateCache::GetTotalCounters(StateType type)
+{
+	return s_data.TotalCounters[(size_t)type];
+}
+
+void RenderStateCache::ResetCounters()
+{
+	s_data.FrameCounters.fill(Counters());
+	s_data.LastFrameCounters.fill(Counters());
+	s_data.TotalCounters.fill(Counters());
+}
\ No newline at end of file
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "Elysium.h"
+
+#include <string>
+
+class SlotTexture;
+
+// Shadows the texture unit bindings and program uniforms the application sets itself and drops
+// calls that would not change anything. Uniforms go through the program directly, so setting
+// them never needs a program bind. Only valid on the thread owning the main context.
+class RenderStateCache
+{
+public:
+	enum class StateType : uint8_t
+	{
+		Texture,
+		Uniform,
+
+		Count
+	};
+
+	struct Counters
+	{
+	public:
+		uint32_t Issued = 0;
+		uint32_t Skipped = 0;
+	};
+public:
+	static void BindTexture(uint32_t unit, const Elysium::Shared<Elysium::Texture2D>& texture);
+	static void BindTexture(uint32_t unit, const Elysium::Shared<SlotTexture>& texture);
+
+	static void SetInt(const Elysium::Shared<Elysium::Shader>& shader, const std::string& name, int value);
+	static void SetFloat(const Elysium::Shared<Elysium::Shader>& shader, const std::string& name, float value);
+	static void SetFloat2(const Elysium::Shared<Elysium::Shader>& shader, const std::string& name, const Elysium::Math::Vec2& value);
+	static void SetFloat4(const Elysium::Shared<Elysium::Shader>& shader, const std::string& name, const Elysium::Math::Vec4& value);
+
+	// Last value set through the cache, false when there is none to put back
+	static bool GetFloat(const Elysium::Shared<Elysium::Shader>& shader, const std::string& name, float& value);
+
+	// Rolls the per frame counters over
+	static void EndFrame();
+
+	static Counters GetFrameCounters(StateType type);
+	static Counters GetTotalCounters(StateType type);
+	static void ResetCounters();
+};
\ No newline at end of file
@@ -0,0 +1,163 @@
+#include "svis_pch.h"
+#include "RenderTargetPool.h"
+
+struct PooledTarget
+{
+	Elysium::Shared<Elysium::FrameBuffer> Target;
+	uint32_t Width = 0;
+	uint32_t Height = 0;
+	std::vector<Elysium::FrameBufferTextureFormat> Formats;
+	uint64_t Bytes = 0;
+	uint64_t LastUsedFrame = 0;
+};
+
+struct RenderTargetPoolData
+{
+	std::vector<PooledTarget> Targets;
+	uint64_t Frame = 0;
+
+	uint64_t InUseBytes = 0;
+	uint64_t CurrentPeakBytes = 0;
+	uint64_t LastPeakBytes = 0;
+
+	uint32_t Created = 0;
+	uint32_t Reused = 0;
+	uint32_t Destroyed = 0;
+};
+
+static RenderTargetPoolData s_data;
+
+static bool IsReferenced(const PooledTarget& target)
+{
+	return target.Target.use_count() > 1;
+}
+
+static uint64_t GetFormatBytes(Elysium::FrameBufferTextureFormat format)
+{
+	switch (format)
+	{
+	case Elysium::FrameBufferTextureFormat::RGBA8:		return 4;
+	case Elysium::FrameBufferTextureFormat::RGBA16F:	return 8;
+	case Elysium::FrameBufferTextureFormat::RGBA32F:	return 16;
+	default:											return 4;
+	}
+}
+
+// Held targets change hands outside the pool, so what is in use is counted again whenever asked
+static void UpdateInUseBytes()
+{
+	s_data.InUseBytes = 0;
+	for (const PooledTarget& target : s_data.Targets)
+	{
+		if (IsReferenced(target))
+			s_data.InUseBytes += target.Bytes;
+	}
+	s_data.CurrentPeakBytes = std::max(s_data.CurrentPeakBytes, s_data.InUseBytes);
+}
+
+void RenderTargetPool::Shutdown()
+{
+	s_data.Targets.clear();
+	s_data.InUseBytes = 0;
+}
+
+Elysium::Shared<Elysium::FrameBuffer> RenderTargetPool::Acquire(uint32_t width, uint32_t height, const std::vector<Elysium::FrameBufferTextureFormat>& formats)
+{
+	width = std::max(width, 1u);
+	height = std::max(height, 1u);
+
+	for (PooledTarget& target : s_data.Targets)
+	{
+		if (IsReferenced(target) || target.Width != width || target.Height != height || target.Formats != formats)
+			continue;
+
+		target.LastUsedFrame = s_data.Frame;
+		++s_data.Reused;
+
+		Elysium::Shared<Elysium::FrameBuffer> framebuffer = target.Target;
+		UpdateInUseBytes();
+		return framebuffer;
+	}
+
+	Elysium::FrameBufferSpecification specs;
+	specs.Attachments = formats;
+	specs.Width = width;
+	specs.Height = height;
+	specs.SwapChainTarget = false;
+
+	PooledTarget target;
+	target.Target = Elysium::FrameBuffer::Create(specs);
+	target.Width = width;
+	target.Height = height;
+	target.Formats = formats;
+	target.LastUsedFrame = s_data.Frame;
+	for (Elysium::FrameBufferTextureFormat format : formats)
+		target.Bytes += static_cast<uint64_t>(width) * height * GetFormatBytes(format);
+
+	s_data.Targets.push_back(std::move(target));
+	++s_data.Created;
+
+	Elysium::Shared<Elysium::FrameBuffer> framebuffer = s_data.Targets.back().Target;
+	UpdateInUseBytes();
+	return framebuffer;
+}
+
+void RenderTargetPool::EndFrame()
+{
+	UpdateInUseBytes();
+	s_data.LastPeakBytes = s_data.CurrentPeakBytes;
+	s_data.CurrentPeakBytes = s_data.InUseBytes;
+
+	++s_data.Frame;
+	for (auto it = s_data.Targets.begin(); it != s_data.Targets.end();)
+	{
+		// Idle time only starts counting once the last holder has let go
+		if (IsReferenced(*it))
+			it->LastUsedFrame = s_data.Frame;
+
+		if (s_data.Frame - it->LastUsedFrame > MaxIdleFrames)
+		{
+			it = s_data.Targets.erase(it);
+			++s_data.Destroyed;
+		}
+		else
+			++it;
+	}
+}
+
+void RenderTargetPool::ReleaseUnused()
+{
+	const size_t previousCount = s_data.Targets.size();
+	s_data.Targets.erase(std::remove_if(s_data.Targets.begin(), s_data.Targets.end(),
+										[](const PooledTarget& target) { return !IsReferenced(target); }), 
+						 s_data.Targets.end());
+	s_data.Destroyed += static_cast<uint32_t>(previousCount - s_data.Targets.size());
+}
+
+RenderTargetPool::Statistics RenderTargetPool::GetStatistics()
+{
+	Statistics stats;
+	stats.TargetCount = static_cast<uint32_t>(s_data.Targets.size());
+	stats.FramePeakBytes = s_data.LastPeakBytes;
+	stats.Created = s_data.Created;
+	stats.Reused = s_data.Reused;
+	stats.Destroyed = s_data.Destroyed;
+
+	for (const PooledTarget& target : s_data.Targets)
+	{
+		stats.AllocatedBytes += target.Bytes;
+		if (IsReferenced(target))
+		{
+			++stats.InUseCount;
+			stats.InUseBytes += target.Bytes;
+		}
+	}
+	return stats;
+}
+
+void RenderTargetPool::ResetCounters()
+{
+	s_data.Created = 0;
+	s_data.Reused = 0;
+	s_data.Destroyed = 0;
+}
\ No newline at end of file
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "Elysium.h"
+
+#include <vector>
+
+// Hands out framebuffers by size and attachment formats, so passes and renderers whose use of a
+// target doesn't overlap share the same memory. A target is in use while anyone besides the pool
+// holds it. Scratch targets are acquired right before a pass draws and dropped once the chain is
+// done with them, the next acquire of the same shape gets that memory back. Targets nobody has
+// held for a few frames are destroyed, so disabled features give their memory back.
+// Only used from the render thread.
+class RenderTargetPool
+{
+public:
+	// Frames a target nobody holds is kept around for
+	static constexpr uint64_t MaxIdleFrames = 3;
+public:
+	struct Statistics
+	{
+	public:
+		uint32_t TargetCount = 0;
+		uint32_t InUseCount = 0;
+		uint64_t AllocatedBytes = 0;
+		uint64_t InUseBytes = 0;
+		// Most memory held at once during the last frame, scratch targets included
+		uint64_t FramePeakBytes = 0;
+
+		uint32_t Created = 0;
+		uint32_t Reused = 0;
+		uint32_t Destroyed = 0;
+	};
+public:
+	// Releases every target, has to happen while the context is still alive
+	static void Shutdown();
+
+	// Contents are undefined, a reused target holds whatever its last user drew
+	static Elysium::Shared<Elysium::FrameBuffer> Acquire(uint32_t width, uint32_t height, const std::vector<Elysium::FrameBufferTextureFormat>& formats);
+
+	// Destroys targets that have been idle for longer than MaxIdleFrames
+	static void EndFrame();
+	// Destroys every target nobody holds
+	static void ReleaseUnused();
+
+	static Statistics GetStatistics();
+	static void ResetCounters();
+};
\ No newline at end of file
@@ -0,0 +1,69 @@
+#include "svis_pch.h"
+#include "TiledRenderer.h"
+
+#include <glad/glad.h>
+
+TiledRenderer::TiledRenderer()
+	: m_width(0),
+	m_height(0),
+	m_tileSize(1),
+	m_tilesX(0),
+	m_tileCount(0),
+	m_nextTile(0)
+{
+}
+
+void TiledRenderer::Restart(uint32_t width, uint32_t height, uint32_t tileSize)
+{
+	m_width = width;
+	m_height = height;
+	m_tileSize = std::max(tileSize, 1u);
+
+	m_tilesX = (m_width + m_tileSize - 1) / m_tileSize;
+	const uint32_t tilesY = (m_height + m_tileSize - 1) / m_tileSize;
+
+	m_tileCount = m_tilesX * tilesY;
+	m_nextTile = 0;
+}
+
+void TiledRenderer::Cancel()
+{
+	m_tileCount = 0;
+	m_nextTile = 0;
+}
+
+uint32_t TiledRenderer::RenderTiles(float budgetMs, const std::function<void()>& drawTile)
+{
+	if (IsComplete())
+		return 0;
+
+	const auto start = std::chrono::steady_clock::now();
+
+	glEnable(GL_SCISSOR_TEST);
+
+	uint32_t tilesDrawn = 0;
+	while (!IsComplete())
+	{
+		const uint32_t tileX = (m_nextTile % m_tilesX) * m_tileSize;
+		const uint32_t tileY = (m_nextTile / m_tilesX) * m_tileSize;
+		const uint32_t tileWidth = std::min(m_tileSize, m_width - tileX);
+		const uint32_t tileHeight = std::min(m_tileSize, m_height - tileY);
+
+		glScissor(tileX, tileY, tileWidth, tileHeight);
+		drawTile();
+
+		// Wait on each tile so the budget reflects gpu time and no single submission runs long
+		glFinish();
+
+		++m_nextTile;
+		++tilesDrawn;
+
+		const float elapsedMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+		if (elapsedMs >= budgetMs)
+			break;
+	}
+
+	glDisable(GL_SCISSOR_TEST);
+
+	return tilesDrawn;
+}
\ No newline at end of file
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <functional>
+
+// Splits a render target into scissored tiles and renders them progressively
+// under a per frame time budget.
+class TiledRenderer
+{
+public:
+	TiledRenderer();
+public:
+	void Restart(uint32_t width, uint32_t height, uint32_t tileSize);
+	void Cancel();
+
+	// Draws as many remaining tiles as fit into the budget, always at least one.
+	// Returns the number of tiles drawn.
+	uint32_t RenderTiles(float budgetMs, const std::function<void()>& drawTile);
+
+	inline bool IsComplete() const { return m_nextTile >= m_tileCount; }
+	inline float GetProgress() const { return m_tileCount == 0 ? 1.0f : m_nextTile / static_cast<float>(m_tileCount); }
+	inline uint32_t GetTileCount() const { return m_tileCount; }
+private:
+	uint32_t m_width;
+	uint32_t m_height;
+	uint32_t m_tileSize;
+	uint32_t m_tilesX;
+
+	uint32_t m_tileCount;
+	uint32_t m_nextTile;
+};
\ No newline at end of file
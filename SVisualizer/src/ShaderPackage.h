@@ -5,18 +5,53 @@
 #include "Elysium/Math/iVec2.h"
 #include "Elysium/Graphics/Shader.h"
 
+#include "Rendering/PassGraph.h"
+
 #include <string>
 #include <array>
 
+enum class BloomFilterMode : uint8_t
+{
+	Gaussian,
+	MipChain,
+
+	Count
+};
+
+// Program variants compiled from the same package code
+enum class ShaderVariant : uint8_t
+{
+	Standard,	// Single color output
+	Bloom,		// Additional bright pass output for the bloom chain
+
+	Count
+};
+using ShaderVariants = std::array<Elysium::Shared<Elysium::Shader>, static_cast<size_t>(ShaderVariant::Count)>;
+
+// Offscreen buffer passes, a pass without code doesn't exist
+using BufferPassCodes = std::array<std::string, PassGraph::MaxBufferPasses>;
+using BufferPassShaders = std::array<Elysium::Shared<Elysium::Shader>, PassGraph::MaxBufferPasses>;
+
 struct ShaderPackage
 {
+public:
+	static constexpr uint8_t MaxTextureSlots = 8;
+	// Package images sit above the units the post passes and the ui bind to, so they stay bound between frames
+	static constexpr uint8_t FirstTextureUnit = 8;
+	static constexpr uint8_t MaxBufferPasses = PassGraph::MaxBufferPasses;
+	// Buffer pass outputs follow the package images
+	static constexpr uint8_t FirstBufferUnit = FirstTextureUnit + MaxTextureSlots;
 public:
 	ShaderPackage()
 		: Dimensions(800, 600),
 		Gamma(2.2f),
 		Exposure(1.0f),
 		BloomEnabled(false),
-		Shader(nullptr)
+		BloomMode(BloomFilterMode::MipChain),
+		Shaders(),
+		TimeDependent(false),
+		Revision(0),
+		StreamRevision(0)
 	{
 	}
 public:
@@ -27,7 +62,13 @@ public:
 		Gamma = 2.2f;
 		Exposure = 1.0f;
 		BloomEnabled = false;
-		Shader = nullptr;
+		BloomMode = BloomFilterMode::MipChain;
+		Shaders.fill(nullptr);
+		BufferCode.fill("");
+		BufferShaders.fill(nullptr);
+		Schedule = PassSchedule();
+		TimeDependent = false;
+		++Revision;
 	}
 public:
 	Elysium::Math::iVec2 Dimensions;
@@ -35,9 +76,24 @@ public:
 	float Gamma;
 	float Exposure;
 	bool BloomEnabled;
+	BloomFilterMode BloomMode;
 
-	std::array<std::string, 8> Textures;
+	std::array<std::string, MaxTextureSlots> Textures;
 
 	std::string Code;
-	Elysium::Shared<Elysium::Shader> Shader;
+	ShaderVariants Shaders;
+
+	// Buffers A-D, drawn before the image in the order of the schedule
+	BufferPassCodes BufferCode;
+	BufferPassShaders BufferShaders;
+	PassSchedule Schedule;
+
+	// Whether the compiled code reads TIME and needs re-rendering as the clock advances.
+	bool TimeDependent;
+
+	// Bumped whenever the compiled shader or its bound textures change.
+	uint32_t Revision;
+	// Bumped whenever a streamed slot moves on to its next frame, like TIME this is picked up
+	// once any tiled frame has completed rather than restarting it.
+	uint32_t StreamRevision;
 };
\ No newline at end of file
@@ -0,0 +1,206 @@
+#include "svis_pch.h"
+#include "ShaderPackageCompiler.h"
+
+#include "Elysium.h"
+
+#include "Elysium/Utils/FileUtils.h"
+#include "Rendering/ProgramBinaryCache.h"
+
+#include <glad/glad.h>
+
+#include <cstring>
+#include <regex>
+
+static std::string InsertFragmentDefine(const std::string& code, const std::string& define)
+{
+	// Defines have to follow the #version directive of the fragment stage
+	const size_t fragmentStage = code.find("#shader fragment");
+	const size_t version = code.find("#version", fragmentStage);
+	if (fragmentStage == std::string::npos || version == std::string::npos)
+		return code;
+
+	const size_t lineEnd = code.find('\n', version);
+	if (lineEnd == std::string::npos)
+		return code;
+
+	std::string result = code;
+	result.insert(lineEnd + 1, "#define " + define + "\n");
+	return result;
+}
+
+static void ParseMessages(const std::string& log, int lineOffset, uint8_t pass, std::vector<ShaderCompileMessage>& messages)
+{
+	// Covers the "0(12) : error", "0:12(5): error" and "ERROR: 0:12:" styles of the common drivers
+	static const std::regex linePattern(R"(^\s*(?:ERROR:\s*|WARNING:\s*)?\d+\s*[:(]\s*(\d+)\s*\)?\s*(?:\(\d+\))?\s*:?\s*(.*)$)");
+
+	std::istringstream stream(log);
+	std::string line;
+	while (std::getline(stream, line))
+	{
+		if (!line.empty() && line.back() == '\r')
+			line.pop_back();
+		if (line.empty())
+			continue;
+
+		ShaderCompileMessage message;
+		message.Pass = pass;
+		std::smatch match;
+		if (std::regex_match(line, match, linePattern))
+		{
+			message.Line = std::max(std::stoi(match[1].str()) - lineOffset, 0);
+			message.Text = match[2].str();
+		}
+		else
+		{
+			message.Text = line;
+		}
+		messages.push_back(std::move(message));
+	}
+}
+
+ShaderPackageCompiler::ShaderPackageCompiler()
+	: m_fragmentLineOffset(0)
+{
+	const std::string solvedFilepath = Elysium::FileUtils::GetAssetPath_Str("Content/shaders/default.shader");
+	std::ifstream defaultShaderStream(solvedFilepath);
+	if (defaultShaderStream.good())
+		m_baseShaderCode = std::move(std::string((std::istreambuf_iterator<char>(defaultShaderStream)), std::istreambuf_iterator<char>()));
+	else
+		ELYSIUM_ERROR("Error Opening Default Shader File!");
+
+	m_bloomBaseShaderCode = InsertFragmentDefine(m_baseShaderCode, "BLOOM_OUTPUT");
+
+	// The package code is appended to the fragment stage, so its first line follows the last base line
+	const size_t fragmentStage = m_baseShaderCode.find("#shader fragment");
+	const size_t fragmentStart = m_baseShaderCode.find('\n', fragmentStage);
+	if (fragmentStage != std::string::npos && fragmentStart != std::string::npos)
+	{
+		m_fragmentStageCode = m_baseShaderCode.substr(fragmentStart + 1);
+		m_fragmentLineOffset = static_cast<int>(std::count(m_fragmentStageCode.begin(), m_fragmentStageCode.end(), '\n'));
+	}
+}
+
+bool ShaderPackageCompiler::Compile(ShaderPackage& shaderPackage, std::string* error) const
+{
+	ShaderVariants newShaders;
+	if (!CompileVariants(shaderPackage.Code, newShaders, error))
+		return false;
+
+	BufferPassShaders newBufferShaders;
+	if (!CompileBuffers(shaderPackage.BufferCode, newBufferShaders, error))
+		return false;
+
+	Apply(shaderPackage, newShaders, newBufferShaders);
+	return true;
+}
+
+bool ShaderPackageCompiler::CompileVariants(const std::string& code, ShaderVariants& output, std::string* error) const
+{
+	// Compile a variant with and without the bloom bright pass output
+	const std::array<const std::string*, (size_t)ShaderVariant::Count> baseCodes = { &m_baseShaderCode, &m_bloomBaseShaderCode };
+
+	ShaderVariants newShaders;
+	for (size_t i = 0; i < newShaders.size(); ++i)
+	{
+		std::stringstream shaderCode;
+		shaderCode << *baseCodes[i];
+		shaderCode << code;
+
+		// Compile this shader code
+		newShaders[i] = ProgramBinaryCache::CreateFromCode(shaderCode.str(), error);
+		if (newShaders[i] == nullptr)
+			return false;
+	}
+
+	for (const Elysium::Shared<Elysium::Shader>& shader : newShaders)
+		BindSamplers(shader);
+
+	output = newShaders;
+	return true;
+}
+
+bool ShaderPackageCompiler::CompileBuffers(const BufferPassCodes& codes, BufferPassShaders& output, std::string* error) const
+{
+	BufferPassShaders newShaders;
+	for (size_t i = 0; i < codes.size(); ++i)
+	{
+		if (codes[i].empty())
+			continue;
+
+		// Buffers hold hdr color and never feed the bloom chain directly
+		newShaders[i] = ProgramBinaryCache::CreateFromCode(m_baseShaderCode + codes[i], error);
+		if (newShaders[i] == nullptr)
+			return false;
+
+		BindSamplers(newShaders[i]);
+	}
+
+	output = newShaders;
+	return true;
+}
+
+bool ShaderPackageCompiler::Validate(const std::string& code, std::vector<ShaderCompileMessage>& messages, uint8_t pass) const
+{
+	if (m_fragmentStageCode.empty())
+		return true;
+
+	const std::string source = m_fragmentStageCode + code;
+	const char* sourcePtr = source.c_str();
+
+	const GLuint shader = glCreateShader(GL_FRAGMENT_SHADER);
+	glShaderSource(shader, 1, &sourcePtr, nullptr);
+	glCompileShader(shader);
+
+	GLint compiled = GL_FALSE;
+	glGetShaderiv(shader, GL_COMPILE_STATUS, &compiled);
+	if (compiled != GL_TRUE)
+	{
+		GLint logLength = 0;
+		glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &logLength);
+
+		std::string log(std::max(logLength, 1), '\0');
+		glGetShaderInfoLog(shader, logLength, nullptr, &log[0]);
+		log.resize(std::strlen(log.c_str()));
+
+		ParseMessages(log, m_fragmentLineOffset, pass, messages);
+	}
+
+	glDeleteShader(shader);
+	return compiled == GL_TRUE;
+}
+
+void ShaderPackageCompiler::Apply(ShaderPackage& shaderPackage, const ShaderVariants& shaders, const BufferPassShaders& bufferShaders)
+{
+	shaderPackage.Shaders = shaders;
+	shaderPackage.BufferShaders = bufferShaders;
+	shaderPackage.Schedule = PassGraph::Resolve(shaderPackage.Code, shaderPackage.BufferCode);
+
+	const auto readsTime = [](const std::string& code)
+	{
+		return PassGraph::ContainsIdentifier(code, "TIME") || PassGraph::ContainsIdentifier(code, "u_Time") ||
+			   PassGraph::ContainsIdentifier(code, "FRAME");
+	};
+
+	// Feedback buffers change every frame even when nothing reads the time
+	shaderPackage.TimeDependent = readsTime(shaderPackage.Code) || shaderPackage.Schedule.HasFeedback();
+	for (uint8_t pass : shaderPackage.Schedule.Order)
+		shaderPackage.TimeDependent |= readsTime(shaderPackage.BufferCode[pass]);
+
+	++shaderPackage.Revision;
+}
+
+void ShaderPackageCompiler::BindSamplers(const Elysium::Shared<Elysium::Shader>& shader)
+{
+	int samplers[ShaderPackage::MaxTextureSlots];
+	for (int i = 0; i < ShaderPackage::MaxTextureSlots; ++i)
+		samplers[i] = ShaderPackage::FirstTextureUnit + i;
+
+	int bufferSamplers[ShaderPackage::MaxBufferPasses];
+	for (int i = 0; i < ShaderPackage::MaxBufferPasses; ++i)
+		bufferSamplers[i] = ShaderPackage::FirstBufferUnit + i;
+
+	shader->Bind();
+	shader->SetIntArray("textureMaps", samplers, ShaderPackage::MaxTextureSlots);
+	shader->SetIntArray("bufferMaps", bufferSamplers, ShaderPackage::MaxBufferPasses);
+	shader->Unbind();
+}
\ No newline at end of file
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "ShaderPackage.h"
+
+// Compiler diagnostic mapped onto the package code
+struct ShaderCompileMessage
+{
+public:
+	// 1-based line in the package code, 0 when it points into the base shader
+	int Line = 0;
+	std::string Text;
+	// Buffer pass the code belongs to, MaxBufferPasses for the image pass
+	uint8_t Pass = ShaderPackage::MaxBufferPasses;
+};
+
+// Builds the standard and bloom program variants of a package from the
+// default base shader and the package's pixel process code, along with
+// a standard program for each of its buffer passes.
+class ShaderPackageCompiler
+{
+public:
+	ShaderPackageCompiler();
+public:
+	// Compiles every variant, leaving the package's current shaders untouched on failure
+	bool Compile(ShaderPackage& shaderPackage, std::string* error = nullptr) const;
+
+	// Compiles every variant of the given code without touching any package
+	bool CompileVariants(const std::string& code, ShaderVariants& output, std::string* error = nullptr) const;
+	// Compiles the buffer passes that have code, the others are left empty
+	bool CompileBuffers(const BufferPassCodes& codes, BufferPassShaders& output, std::string* error = nullptr) const;
+
+	// Compiles only the fragment stage of the standard variant without linking, a much cheaper way
+	// to catch errors in the package code before every variant is built
+	bool Validate(const std::string& code, std::vector<ShaderCompileMessage>& messages, uint8_t pass = ShaderPackage::MaxBufferPasses) const;
+
+	// Swaps the package over to freshly compiled variants of its code and reschedules its buffer passes
+	static void Apply(ShaderPackage& shaderPackage, const ShaderVariants& shaders, const BufferPassShaders& bufferShaders);
+
+	inline bool IsValid() const { return !m_baseShaderCode.empty(); }
+private:
+	// Points the sampler arrays at the package image and buffer units
+	static void BindSamplers(const Elysium::Shared<Elysium::Shader>& shader);
+private:
+	std::string m_baseShaderCode;
+	std::string m_bloomBaseShaderCode;
+
+	std::string m_fragmentStageCode;
+	int m_fragmentLineOffset;
+};
\ No newline at end of file
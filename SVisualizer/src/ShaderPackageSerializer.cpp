@@ -15,6 +15,7 @@ void ShaderPackageSerializer::Serialize(const std::string& filepath, const Shade
 	out << YAML::Key << "Width" << YAML::Value << shaderPackage.Dimensions.width;
 	out << YAML::Key << "Height" << YAML::Value << shaderPackage.Dimensions.height;
 	out << YAML::Key << "Bloom" << YAML::Value << shaderPackage.BloomEnabled;
+	out << YAML::Key << "Bloom_Mode" << YAML::Value << static_cast<int>(shaderPackage.BloomMode);
 	out << YAML::Key << "Gamma" << YAML::Value << shaderPackage.Gamma;
 	out << YAML::Key << "Exposure" << YAML::Value << shaderPackage.Exposure;
 	out << YAML::EndMap;
@@ -31,6 +32,27 @@ void ShaderPackageSerializer::Serialize(const std::string& filepath, const Shade
 
 	out << YAML::Key << "Code" << YAML::Value << shaderPackage.Code;
 
+	// Only buffers with code are written, packages without any stay as they were
+	bool hasBuffers = false;
+	for (const std::string& bufferCode : shaderPackage.BufferCode)
+		hasBuffers |= !bufferCode.empty();
+
+	if (hasBuffers)
+	{
+		out << YAML::Key << "Buffers" << YAML::Value << YAML::BeginSeq;
+		for (uint8_t i = 0; i < shaderPackage.BufferCode.size(); ++i)
+		{
+			if (shaderPackage.BufferCode[i].empty())
+				continue;
+
+			out << YAML::BeginMap;
+			out << YAML::Key << "Pass" << YAML::Value << std::string(1, static_cast<char>('A' + i));
+			out << YAML::Key << "Code" << YAML::Value << shaderPackage.BufferCode[i];
+			out << YAML::EndMap;
+		}
+		out << YAML::EndSeq;
+	}
+
 	out << YAML::EndMap;
 
 	std::ofstream stream(filepath);
@@ -49,6 +71,9 @@ bool ShaderPackageSerializer::Deserialize(ShaderPackage& shaderPackage, const st
 		shaderPackage.Dimensions.width = renderSettings["Width"].as<int>();
 		shaderPackage.Dimensions.height = renderSettings["Height"].as<int>();
 		shaderPackage.BloomEnabled = renderSettings["Bloom"].as<bool>();
+		// Packages saved before the mode existed keep the gaussian chain they were made with
+		const int bloomMode = renderSettings["Bloom_Mode"] ? renderSettings["Bloom_Mode"].as<int>() : static_cast<int>(BloomFilterMode::Gaussian);
+		shaderPackage.BloomMode = static_cast<BloomFilterMode>(std::min(std::max(bloomMode, 0), static_cast<int>(BloomFilterMode::Count) - 1));
 		shaderPackage.Gamma = renderSettings["Gamma"].as<float>();
 		shaderPackage.Exposure = renderSettings["Exposure"].as<float>();
 	}
@@ -67,5 +92,22 @@ bool ShaderPackageSerializer::Deserialize(ShaderPackage& shaderPackage, const st
 	if (code)
 		shaderPackage.Code = code.as<std::string>();
 
+	shaderPackage.BufferCode = {};
+	auto buffers = data["Buffers"];
+	if (buffers)
+	{
+		for (auto buffer : buffers)
+		{
+			const std::string pass = buffer["Pass"].as<std::string>();
+			const int index = pass.size() == 1 ? pass[0] - 'A' : -1;
+			if (index < 0 || index >= ShaderPackage::MaxBufferPasses)
+			{
+				ELYSIUM_WARN("Skipping Unknown Buffer Pass {0} in {1}", pass, filepath);
+				continue;
+			}
+			shaderPackage.BufferCode[index] = buffer["Code"].as<std::string>();
+		}
+	}
+
 	return true;
-}
+}
\ No newline at end of file
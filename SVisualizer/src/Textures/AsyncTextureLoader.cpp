@@ -0,0 +1,222 @@
+#include "svis_pch.h"
+#include "AsyncTextureLoader.h"
+
+#include "Textures/TextureCache.h"
+#include "Textures/DdsFile.h"
+
+#include <glad/glad.h>
+
+static constexpr uint32_t QueueCapacity = 32;
+
+AsyncTextureLoader::AsyncTextureLoader()
+	: m_inFlight(0),
+	m_nextRequestId(0)
+{
+	// Leave a core to the render thread
+	const uint32_t hardwareThreads = std::max(std::thread::hardware_concurrency(), 2u);
+	m_workers.Start(std::min(hardwareThreads - 1, 4u), QueueCapacity);
+}
+
+AsyncTextureLoader::~AsyncTextureLoader()
+{
+	// Nobody is waiting on the images anymore
+	m_workers.Clear();
+	m_workers.Stop();
+
+	for (PendingCacheWrite& write : m_pendingCacheWrites)
+	{
+		glDeleteSync(static_cast<GLsync>(write.Fence));
+		glDeleteBuffers(1, &write.Buffer);
+	}
+}
+
+uint64_t AsyncTextureLoader::Request(const std::string& filepath)
+{
+	const uint64_t requestId = ++m_nextRequestId;
+	// Loads with other options end up as different textures
+	std::string cacheKey = TextureCache::MakeKey(filepath);
+	if (!cacheKey.empty())
+		cacheKey += m_options.GenerateMips ? "|mips" : "|base";
+	if (!cacheKey.empty() && m_options.Compress)
+		cacheKey += "|compressed";
+
+	Result result;
+	result.RequestId = requestId;
+	result.Filepath = filepath;
+
+	if (!cacheKey.empty())
+	{
+		auto shared = m_sharedRequests.find(cacheKey);
+		if (shared != m_sharedRequests.end())
+		{
+			shared->second.push_back(std::move(result));
+			return requestId;
+		}
+
+		result.Texture = TextureCache::Find(cacheKey);
+		if (result.Texture != nullptr)
+		{
+			m_ready.push_back(std::move(result));
+			return requestId;
+		}
+
+		m_sharedRequests[cacheKey];
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		++m_inFlight;
+	}
+
+	DecodedImage image;
+	image.RequestId = requestId;
+	image.Filepath = filepath;
+	image.CacheKey = cacheKey;
+	image.Options = m_options;
+	m_waiting.push_back(std::move(image));
+
+	SubmitWaiting();
+	return requestId;
+}
+
+void AsyncTextureLoader::Update(std::vector<Result>& finished)
+{
+	SubmitWaiting();
+	CollectCacheWrites();
+
+	for (Result& result : m_ready)
+		finished.push_back(std::move(result));
+	m_ready.clear();
+
+	size_t uploadedBytes = 0;
+	while (true)
+	{
+		DecodedImage image;
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			if (m_decoded.empty())
+				break;
+
+			const uint64_t imageBytes = m_decoded.front().Image.GetByteSize();
+			if (uploadedBytes > 0 && uploadedBytes + imageBytes > MaxUploadBytesPerUpdate)
+				break;
+
+			image = std::move(m_decoded.front());
+			m_decoded.pop_front();
+			--m_inFlight;
+		}
+
+		Result result;
+		result.RequestId = image.RequestId;
+		result.Filepath = image.Filepath;
+
+		// Failed decodes are reported without a texture
+		if (image.Image.IsValid())
+		{
+			result.Texture = SlotTexture::Create(image.Image, image.Options.Compress);
+			uploadedBytes += image.Image.GetByteSize();
+
+			if (image.WriteCompressedCache)
+				WriteCompressedCache(*result.Texture, image.Filepath);
+
+			TextureCache::Insert(image.CacheKey, result.Texture, result.Texture->GetByteSize());
+		}
+
+		auto shared = m_sharedRequests.find(image.CacheKey);
+		if (shared != m_sharedRequests.end())
+		{
+			for (Result& sharedResult : shared->second)
+			{
+				sharedResult.Texture = result.Texture;
+				finished.push_back(std::move(sharedResult));
+			}
+			m_sharedRequests.erase(shared);
+		}
+		finished.push_back(std::move(result));
+	}
+}
+
+bool AsyncTextureLoader::IsBusy() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_inFlight > 0 || !m_ready.empty();
+}
+
+void AsyncTextureLoader::Decode(DecodedImage image)
+{
+	// Containers already hold the format their author picked
+	if (ImageDecoder::IsContainer(image.Filepath))
+		image.Options.Compress = false;
+
+	bool fromCompressedCache = false;
+	if (ImageDecoder::Load(image.Filepath, image.Options, image.Image, fromCompressedCache))
+		image.WriteCompressedCache = image.Options.Compress && !image.Image.IsCompressed() && !fromCompressedCache;
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_decoded.push_back(std::move(image));
+}
+
+void AsyncTextureLoader::SubmitWaiting()
+{
+	while (!m_waiting.empty())
+	{
+		DecodedImage image = m_waiting.front();
+		if (!m_workers.TryPush([this, image]() { Decode(image); }))
+			break;
+
+		m_waiting.pop_front();
+	}
+}
+
+void AsyncTextureLoader::WriteCompressedCache(const SlotTexture& texture, const std::string& filepath)
+{
+	// Costs a readback once, every later load skips both the decode and the compression.
+	// The copy is queued behind the upload and collected on a later update.
+	PendingCacheWrite write;
+	write.CachePath = ImageDecoder::GetCompressedCachePath(filepath);
+	write.Image = Elysium::CreateShared<ImageData>();
+
+	glCreateBuffers(1, &write.Buffer);
+	if (!texture.QueueReadBack(write.Buffer, *write.Image))
+	{
+		glDeleteBuffers(1, &write.Buffer);
+		return;
+	}
+
+	write.Fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	m_pendingCacheWrites.push_back(std::move(write));
+}
+
+void AsyncTextureLoader::CollectCacheWrites()
+{
+	for (auto it = m_pendingCacheWrites.begin(); it != m_pendingCacheWrites.end();)
+	{
+		// Poll without waiting, the write is picked up on a later update otherwise
+		GLsync fence = static_cast<GLsync>(it->Fence);
+		const GLenum status = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+		if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED)
+		{
+			++it;
+			continue;
+		}
+		glDeleteSync(fence);
+
+		// The copy has completed, so reading the buffer doesn't wait on the gpu
+		size_t offset = 0;
+		for (ImageLevel& level : it->Image->Levels)
+		{
+			glGetNamedBufferSubData(it->Buffer, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(level.Data.size()), level.Data.data());
+			offset += level.Data.size();
+		}
+		glDeleteBuffers(1, &it->Buffer);
+
+		Elysium::Shared<ImageData> compressed = it->Image;
+		const std::string cachePath = it->CachePath;
+		m_workers.TryPush([compressed, cachePath]()
+		{
+			if (!DdsFile::Write(cachePath, *compressed))
+				ELYSIUM_WARN("Failed to Write Compressed Image Cache {0}", cachePath);
+		});
+		it = m_pendingCacheWrites.erase(it);
+	}
+}
\ No newline at end of file
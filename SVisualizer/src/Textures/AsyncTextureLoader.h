@@ -0,0 +1,88 @@
+#pragma once
+
+#include "Elysium.h"
+
+#include "Export/EncodeQueue.h"
+#include "Textures/ImageDecoder.h"
+#include "Textures/SlotTexture.h"
+
+// Decodes images on a pool of worker threads and uploads them on the render thread as they
+// finish. Uploads are spread over frames so a batch of large images never stalls a single one.
+// Images already in the texture cache, or already being decoded for another request, are shared.
+class AsyncTextureLoader
+{
+public:
+	// At least one image is uploaded per update, further ones only while under this budget
+	static constexpr size_t MaxUploadBytesPerUpdate = 32 * 1024 * 1024;
+public:
+	struct Result
+	{
+	public:
+		uint64_t RequestId = 0;
+		std::string Filepath;
+		Elysium::Shared<SlotTexture> Texture;
+	};
+public:
+	AsyncTextureLoader();
+	~AsyncTextureLoader();
+public:
+	uint64_t Request(const std::string& filepath);
+
+	// Uploads finished decodes, has to be called on the render thread
+	void Update(std::vector<Result>& finished);
+
+	// Whether any request is still decoding or waiting for its upload
+	bool IsBusy() const;
+
+	// Applies to requests made from here on
+	inline void SetOptions(const ImageLoadOptions& options) { m_options = options; }
+	inline const ImageLoadOptions& GetOptions() const { return m_options; }
+private:
+	struct DecodedImage
+	{
+	public:
+		uint64_t RequestId = 0;
+		std::string Filepath;
+		std::string CacheKey;
+		ImageLoadOptions Options;
+
+		ImageData Image;
+		// Set when the driver compresses the image, so the result is worth keeping on disk
+		bool WriteCompressedCache = false;
+	};
+private:
+	void Decode(DecodedImage image);
+	void SubmitWaiting();
+	void WriteCompressedCache(const SlotTexture& texture, const std::string& filepath);
+	// Hands finished readbacks to the workers to be written out
+	void CollectCacheWrites();
+private:
+	ImageLoadOptions m_options;
+
+	EncodeQueue m_workers;
+
+	mutable std::mutex m_mutex;
+	std::deque<DecodedImage> m_decoded;
+	uint32_t m_inFlight;
+
+	// Requests the worker queue had no room for yet
+	std::deque<DecodedImage> m_waiting;
+
+	// Cache hits, handed out on the next update like any other result
+	std::vector<Result> m_ready;
+	// Further requests waiting on a decode that is already running, by cache key
+	std::unordered_map<std::string, std::vector<Result>> m_sharedRequests;
+
+	// Compressed images being read back into pack buffers, collected once their fence has passed
+	struct PendingCacheWrite
+	{
+	public:
+		std::string CachePath;
+		Elysium::Shared<ImageData> Image;
+		uint32_t Buffer = 0;
+		void* Fence = nullptr;
+	};
+	std::vector<PendingCacheWrite> m_pendingCacheWrites;
+
+	uint64_t m_nextRequestId;
+};
\ No newline at end of file
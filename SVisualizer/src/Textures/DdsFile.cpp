@@ -0,0 +1,224 @@
+#include "svis_pch.h"
+#include "DdsFile.h"
+
+static constexpr uint32_t DdsMagic = 0x20534444; // "DDS "
+
+static constexpr uint32_t DdsFlagCaps = 0x1;
+static constexpr uint32_t DdsFlagHeight = 0x2;
+static constexpr uint32_t DdsFlagWidth = 0x4;
+static constexpr uint32_t DdsFlagPixelFormat = 0x1000;
+static constexpr uint32_t DdsFlagMipMapCount = 0x20000;
+static constexpr uint32_t DdsFlagLinearSize = 0x80000;
+
+static constexpr uint32_t DdsPixelFlagFourCC = 0x4;
+static constexpr uint32_t DdsPixelFlagRGB = 0x40;
+
+static constexpr uint32_t DdsCapsTexture = 0x1000;
+static constexpr uint32_t DdsCapsComplex = 0x8;
+static constexpr uint32_t DdsCapsMipMap = 0x400000;
+
+static constexpr uint32_t DdsDimensionTexture2D = 3;
+
+static constexpr uint32_t MakeFourCC(char a, char b, char c, char d)
+{
+	return static_cast<uint32_t>(a) | (static_cast<uint32_t>(b) << 8) | (static_cast<uint32_t>(c) << 16) | (static_cast<uint32_t>(d) << 24);
+}
+
+struct DdsPixelFormat
+{
+	uint32_t Size;
+	uint32_t Flags;
+	uint32_t FourCC;
+	uint32_t RGBBitCount;
+	uint32_t RBitMask;
+	uint32_t GBitMask;
+	uint32_t BBitMask;
+	uint32_t ABitMask;
+};
+
+struct DdsHeader
+{
+	uint32_t Size;
+	uint32_t Flags;
+	uint32_t Height;
+	uint32_t Width;
+	uint32_t PitchOrLinearSize;
+	uint32_t Depth;
+	uint32_t MipMapCount;
+	uint32_t Reserved1[11];
+	DdsPixelFormat PixelFormat;
+	uint32_t Caps;
+	uint32_t Caps2;
+	uint32_t Caps3;
+	uint32_t Caps4;
+	uint32_t Reserved2;
+};
+
+struct DdsHeaderDX10
+{
+	uint32_t DxgiFormat;
+	uint32_t ResourceDimension;
+	uint32_t MiscFlag;
+	uint32_t ArraySize;
+	uint32_t MiscFlags2;
+};
+
+static_assert(sizeof(DdsHeader) == 124, "Unexpected dds header size.");
+static_assert(sizeof(DdsHeaderDX10) == 20, "Unexpected dds dx10 header size.");
+
+// The srgb variants hold the same data, slots sample everything as linear like the png path
+static bool FormatFromDxgi(uint32_t dxgiFormat, ImagePixelFormat& format)
+{
+	switch (dxgiFormat)
+	{
+		case 28: case 29:	format = ImagePixelFormat::RGBA8;	return true;
+		case 71: case 72:	format = ImagePixelFormat::BC1;		return true;
+		case 77: case 78:	format = ImagePixelFormat::BC3;		return true;
+		case 80:			format = ImagePixelFormat::BC4;		return true;
+		case 83:			format = ImagePixelFormat::BC5;		return true;
+		case 98: case 99:	format = ImagePixelFormat::BC7;		return true;
+		default:
+			return false;
+	}
+}
+
+static uint32_t DxgiFromFormat(ImagePixelFormat format)
+{
+	switch (format)
+	{
+		case ImagePixelFormat::BC1:	return 71;
+		case ImagePixelFormat::BC3:	return 77;
+		case ImagePixelFormat::BC4:	return 80;
+		case ImagePixelFormat::BC5:	return 83;
+		case ImagePixelFormat::BC7:	return 98;
+		default:					return 28;
+	}
+}
+
+static bool FormatFromPixelFormat(const DdsPixelFormat& pixelFormat, ImagePixelFormat& format)
+{
+	if (pixelFormat.Flags & DdsPixelFlagFourCC)
+	{
+		switch (pixelFormat.FourCC)
+		{
+			case MakeFourCC('D', 'X', 'T', '1'):	format = ImagePixelFormat::BC1;	return true;
+			case MakeFourCC('D', 'X', 'T', '5'):	format = ImagePixelFormat::BC3;	return true;
+			case MakeFourCC('A', 'T', 'I', '1'):
+			case MakeFourCC('B', 'C', '4', 'U'):	format = ImagePixelFormat::BC4;	return true;
+			case MakeFourCC('A', 'T', 'I', '2'):
+			case MakeFourCC('B', 'C', '5', 'U'):	format = ImagePixelFormat::BC5;	return true;
+			default:
+				return false;
+		}
+	}
+
+	// Only byte ordered rgba is taken as is
+	if ((pixelFormat.Flags & DdsPixelFlagRGB) && pixelFormat.RGBBitCount == 32 &&
+		pixelFormat.RBitMask == 0x000000ff && pixelFormat.GBitMask == 0x0000ff00 && pixelFormat.BBitMask == 0x00ff0000)
+	{
+		format = ImagePixelFormat::RGBA8;
+		return true;
+	}
+	return false;
+}
+
+static bool Fail(std::string* error, const char* message)
+{
+	if (error)
+		*error = message;
+	return false;
+}
+
+bool DdsFile::Read(const std::string& filepath, ImageData& image, std::string* error)
+{
+	std::ifstream stream(filepath, std::ios::binary);
+	if (!stream.good())
+		return Fail(error, "Unable to open file.");
+
+	uint32_t magic = 0;
+	DdsHeader header;
+	stream.read(reinterpret_cast<char*>(&magic), sizeof(magic));
+	stream.read(reinterpret_cast<char*>(&header), sizeof(header));
+	if (!stream || magic != DdsMagic || header.Size != sizeof(DdsHeader))
+		return Fail(error, "Not a dds file.");
+
+	if (header.Width == 0 || header.Height == 0 || header.Depth > 1)
+		return Fail(error, "Only 2d dds images are supported.");
+
+	ImagePixelFormat format = ImagePixelFormat::RGBA8;
+	if ((header.PixelFormat.Flags & DdsPixelFlagFourCC) && header.PixelFormat.FourCC == MakeFourCC('D', 'X', '1', '0'))
+	{
+		DdsHeaderDX10 headerDX10;
+		stream.read(reinterpret_cast<char*>(&headerDX10), sizeof(headerDX10));
+		if (!stream || headerDX10.ResourceDimension != DdsDimensionTexture2D || headerDX10.ArraySize > 1)
+			return Fail(error, "Only single 2d dds images are supported.");
+
+		if (!FormatFromDxgi(headerDX10.DxgiFormat, format))
+			return Fail(error, "Unsupported dds format, expected BC1, BC3, BC4, BC5, BC7 or RGBA8.");
+	}
+	else if (!FormatFromPixelFormat(header.PixelFormat, format))
+	{
+		return Fail(error, "Unsupported dds format, expected BC1, BC3, BC4, BC5, BC7 or RGBA8.");
+	}
+
+	const uint32_t levelCount = (header.Flags & DdsFlagMipMapCount) ? std::max(header.MipMapCount, 1u) : 1;
+
+	image.Format = format;
+	image.Levels.clear();
+	image.Levels.reserve(levelCount);
+
+	uint32_t width = header.Width;
+	uint32_t height = header.Height;
+	for (uint32_t i = 0; i < levelCount; ++i)
+	{
+		ImageLevel level;
+		level.Width = width;
+		level.Height = height;
+		level.Data.resize(ImageData::GetLevelSize(format, width, height));
+
+		stream.read(reinterpret_cast<char*>(level.Data.data()), level.Data.size());
+		if (!stream)
+			return Fail(error, "Truncated dds file.");
+
+		image.Levels.push_back(std::move(level));
+
+		width = std::max(width / 2, 1u);
+		height = std::max(height / 2, 1u);
+	}
+	return true;
+}
+
+bool DdsFile::Write(const std::string& filepath, const ImageData& image)
+{
+	if (!image.IsValid())
+		return false;
+
+	DdsHeader header = {};
+	header.Size = sizeof(DdsHeader);
+	header.Flags = DdsFlagCaps | DdsFlagHeight | DdsFlagWidth | DdsFlagPixelFormat | DdsFlagMipMapCount | DdsFlagLinearSize;
+	header.Height = image.GetHeight();
+	header.Width = image.GetWidth();
+	header.PitchOrLinearSize = static_cast<uint32_t>(image.Levels[0].Data.size());
+	header.MipMapCount = static_cast<uint32_t>(image.Levels.size());
+	header.PixelFormat.Size = sizeof(DdsPixelFormat);
+	header.PixelFormat.Flags = DdsPixelFlagFourCC;
+	header.PixelFormat.FourCC = MakeFourCC('D', 'X', '1', '0');
+	header.Caps = DdsCapsTexture | (image.Levels.size() > 1 ? DdsCapsComplex | DdsCapsMipMap : 0);
+
+	DdsHeaderDX10 headerDX10 = {};
+	headerDX10.DxgiFormat = DxgiFromFormat(image.Format);
+	headerDX10.ResourceDimension = DdsDimensionTexture2D;
+	headerDX10.ArraySize = 1;
+
+	std::ofstream stream(filepath, std::ios::binary | std::ios::trunc);
+	if (!stream.good())
+		return false;
+
+	stream.write(reinterpret_cast<const char*>(&DdsMagic), sizeof(DdsMagic));
+	stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	stream.write(reinterpret_cast<const char*>(&headerDX10), sizeof(headerDX10));
+	for (const ImageLevel& level : image.Levels)
+		stream.write(reinterpret_cast<const char*>(level.Data.data()), level.Data.size());
+
+	return stream.good();
+}
\ No newline at end of file
@@ -0,0 +1,15 @@
+#pragma once
+
+#include "Textures/ImageData.h"
+
+// Reads and writes DirectDraw Surface files holding a single 2d image with its mip chain,
+// in one of the block compressed or 32-bit rgba formats the slots accept.
+class DdsFile
+{
+public:
+	// Levels are returned as stored, which for dds means top row first
+	static bool Read(const std::string& filepath, ImageData& image, std::string* error = nullptr);
+
+	// Always writes the extended dx10 header, rows are written in the order they are given
+	static bool Write(const std::string& filepath, const ImageData& image);
+};
\ No newline at end of file
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+enum class ImagePixelFormat : uint8_t
+{
+	RGBA8,
+	BC1,	// rgb + 1-bit alpha, 8 bytes per 4x4 block
+	BC3,	// rgba, 16 bytes per 4x4 block
+	BC4,	// single channel, 8 bytes per 4x4 block
+	BC5,	// two channels, 16 bytes per 4x4 block
+	BC7,	// high quality rgba, 16 bytes per 4x4 block
+
+	Count
+};
+
+struct ImageLevel
+{
+public:
+	uint32_t Width = 0;
+	uint32_t Height = 0;
+	std::vector<uint8_t> Data;
+};
+
+// Cpu side image with its full mip chain, rows ordered bottom to top as in gl
+struct ImageData
+{
+public:
+	inline bool IsValid() const { return !Levels.empty(); }
+	inline bool IsCompressed() const { return Format != ImagePixelFormat::RGBA8; }
+
+	inline uint32_t GetWidth() const { return Levels.empty() ? 0 : Levels[0].Width; }
+	inline uint32_t GetHeight() const { return Levels.empty() ? 0 : Levels[0].Height; }
+
+	uint64_t GetByteSize() const
+	{
+		uint64_t size = 0;
+		for (const ImageLevel& level : Levels)
+			size += level.Data.size();
+		return size;
+	}
+
+	// Bytes per 4x4 block, or per pixel for uncompressed data
+	static uint32_t GetBlockSize(ImagePixelFormat format)
+	{
+		switch (format)
+		{
+			case ImagePixelFormat::BC1:
+			case ImagePixelFormat::BC4:
+				return 8;
+			case ImagePixelFormat::BC3:
+			case ImagePixelFormat::BC5:
+			case ImagePixelFormat::BC7:
+				return 16;
+			default:
+				return 4;
+		}
+	}
+
+	static const char* GetFormatName(ImagePixelFormat format)
+	{
+		constexpr const char* names[] = { "RGBA8", "BC1", "BC3", "BC4", "BC5", "BC7" };
+		return format < ImagePixelFormat::Count ? names[static_cast<size_t>(format)] : "Unknown";
+	}
+
+	static size_t GetLevelSize(ImagePixelFormat format, uint32_t width, uint32_t height)
+	{
+		if (format == ImagePixelFormat::RGBA8)
+			return static_cast<size_t>(width) * height * 4;
+
+		const size_t blocksX = std::max((width + 3) / 4, 1u);
+		const size_t blocksY = std::max((height + 3) / 4, 1u);
+		return blocksX * blocksY * GetBlockSize(format);
+	}
+public:
+	ImagePixelFormat Format = ImagePixelFormat::RGBA8;
+	std::vector<ImageLevel> Levels;
+};
\ No newline at end of file
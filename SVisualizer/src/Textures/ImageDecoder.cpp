@@ -0,0 +1,266 @@
+#include "svis_pch.h"
+#include "ImageDecoder.h"
+
+#include "Elysium.h"
+
+#include "Textures/DdsFile.h"
+#include "Textures/Ktx2File.h"
+
+#include <stb_image.h>
+
+#include <cstring>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+static std::string GetLowerExtension(const std::string& filepath)
+{
+	std::string extension = fs::path(filepath).extension().string();
+	std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+	return extension;
+}
+
+// Bc1 color indices take a byte per row
+static void FlipColorBlock(uint8_t* block, uint32_t rows)
+{
+	std::reverse(block + 4, block + 4 + rows);
+}
+
+// Bc4 style blocks pack 3-bit indices, 12 bits per row, after the two endpoints
+static void FlipChannelBlock(uint8_t* block, uint32_t rows)
+{
+	uint64_t bits = 0;
+	for (uint32_t i = 0; i < 6; ++i)
+		bits |= static_cast<uint64_t>(block[2 + i]) << (8 * i);
+
+	uint64_t flipped = bits;
+	for (uint32_t y = 0; y < rows; ++y)
+	{
+		const uint64_t row = (bits >> (12 * (rows - 1 - y))) & 0xFFF;
+		flipped &= ~(0xFFFull << (12 * y));
+		flipped |= row << (12 * y);
+	}
+
+	for (uint32_t i = 0; i < 6; ++i)
+		block[2 + i] = static_cast<uint8_t>(flipped >> (8 * i));
+}
+
+static void FlipBlock(ImagePixelFormat format, uint8_t* block, uint32_t rows)
+{
+	switch (format)
+	{
+		case ImagePixelFormat::BC1:
+			FlipColorBlock(block, rows);
+			break;
+		case ImagePixelFormat::BC3:
+			FlipChannelBlock(block, rows);
+			FlipColorBlock(block + 8, rows);
+			break;
+		case ImagePixelFormat::BC4:
+			FlipChannelBlock(block, rows);
+			break;
+		case ImagePixelFormat::BC5:
+			FlipChannelBlock(block, rows);
+			FlipChannelBlock(block + 8, rows);
+			break;
+		default:
+			break;
+	}
+}
+
+static bool CanFlipLevel(ImagePixelFormat format, const ImageLevel& level)
+{
+	if (format == ImagePixelFormat::RGBA8)
+		return true;
+
+	// Bc7 partitions and modes are not laid out by row
+	if (format == ImagePixelFormat::BC7)
+		return false;
+
+	// A partially filled last block row would have to be split across two blocks
+	return level.Height <= 4 || level.Height % 4 == 0;
+}
+
+static void FlipLevel(ImagePixelFormat format, ImageLevel& level)
+{
+	if (format == ImagePixelFormat::RGBA8)
+	{
+		const size_t rowSize = static_cast<size_t>(level.Width) * 4;
+		for (uint32_t y = 0; y < level.Height / 2; ++y)
+			std::swap_ranges(&level.Data[y * rowSize], &level.Data[(y + 1) * rowSize], &level.Data[(level.Height - 1 - y) * rowSize]);
+		return;
+	}
+
+	const uint32_t blockSize = ImageData::GetBlockSize(format);
+	const uint32_t blocksX = std::max((level.Width + 3) / 4, 1u);
+	const uint32_t blocksY = std::max((level.Height + 3) / 4, 1u);
+	const uint32_t rows = std::min(level.Height, 4u);
+	const size_t blockRowSize = static_cast<size_t>(blocksX) * blockSize;
+
+	for (uint32_t y = 0; y < blocksY / 2; ++y)
+		std::swap_ranges(&level.Data[y * blockRowSize], &level.Data[(y + 1) * blockRowSize], &level.Data[(blocksY - 1 - y) * blockRowSize]);
+
+	for (size_t offset = 0; offset < level.Data.size(); offset += blockSize)
+		FlipBlock(format, &level.Data[offset], rows);
+}
+
+static bool DecodePlainImage(const std::string& filepath, ImageData& image)
+{
+	int width = 0;
+	int height = 0;
+	int channels = 0;
+	stbi_uc* pixels = stbi_load(filepath.c_str(), &width, &height, &channels, 4);
+	if (pixels == nullptr)
+	{
+		ELYSIUM_WARN("Failed to Decode Image {0}: {1}", filepath, stbi_failure_reason());
+		return false;
+	}
+
+	ImageLevel level;
+	level.Width = static_cast<uint32_t>(width);
+	level.Height = static_cast<uint32_t>(height);
+	level.Data.resize(static_cast<size_t>(width) * height * 4);
+
+	// Flip here rather than through stb's global flag, which every decoding thread would share
+	const size_t rowSize = static_cast<size_t>(width) * 4;
+	for (int y = 0; y < height; ++y)
+		std::memcpy(&level.Data[(height - 1 - y) * rowSize], pixels + y * rowSize, rowSize);
+
+	stbi_image_free(pixels);
+
+	image.Format = ImagePixelFormat::RGBA8;
+	image.Levels.clear();
+	image.Levels.push_back(std::move(level));
+	return true;
+}
+
+static bool TryLoadCompressedCache(const std::string& filepath, const ImageLoadOptions& options, ImageData& image)
+{
+	const std::string cachePath = ImageDecoder::GetCompressedCachePath(filepath);
+
+	std::error_code error;
+	const fs::file_time_type sourceTime = fs::last_write_time(filepath, error);
+	if (error)
+		return false;
+
+	const fs::file_time_type cacheTime = fs::last_write_time(cachePath, error);
+	if (error || cacheTime < sourceTime)
+		return false;
+
+	int width = 0;
+	int height = 0;
+	int channels = 0;
+	if (!stbi_info(filepath.c_str(), &width, &height, &channels))
+		return false;
+
+	// The cache is written from the uploaded texture, its rows are already bottom up
+	ImageData cached;
+	if (!DdsFile::Read(cachePath, cached) || cached.Format != ImageDecoder::CompressedFormat)
+		return false;
+
+	const bool hasMips = cached.Levels.size() > 1;
+	if (cached.GetWidth() != static_cast<uint32_t>(width) || cached.GetHeight() != static_cast<uint32_t>(height) || hasMips != options.GenerateMips)
+		return false;
+
+	image = std::move(cached);
+	return true;
+}
+
+bool ImageDecoder::Load(const std::string& filepath, const ImageLoadOptions& options, ImageData& image, bool& fromCompressedCache)
+{
+	fromCompressedCache = false;
+
+	if (IsContainer(filepath))
+	{
+		std::string error;
+		const bool loaded = GetLowerExtension(filepath) == ".dds" ? DdsFile::Read(filepath, image, &error) : Ktx2File::Read(filepath, image, &error);
+		if (!loaded)
+		{
+			ELYSIUM_WARN("Failed to Load Image {0}: {1}", filepath, error);
+			return false;
+		}
+
+		if (!FlipVertically(image))
+			ELYSIUM_WARN("Can't Flip {0} on Load, Store it Flipped Vertically to Sample it Upright.", filepath);
+
+		if (options.GenerateMips && !image.IsCompressed() && image.Levels.size() == 1)
+			GenerateMipChain(image);
+		return true;
+	}
+
+	if (options.Compress && TryLoadCompressedCache(filepath, options, image))
+	{
+		fromCompressedCache = true;
+		return true;
+	}
+
+	if (!DecodePlainImage(filepath, image))
+		return false;
+
+	if (options.GenerateMips)
+		GenerateMipChain(image);
+	return true;
+}
+
+bool ImageDecoder::IsContainer(const std::string& filepath)
+{
+	const std::string extension = GetLowerExtension(filepath);
+	return extension == ".dds" || extension == ".ktx2";
+}
+
+std::string ImageDecoder::GetCompressedCachePath(const std::string& filepath)
+{
+	return filepath + ".bc3.dds";
+}
+
+void ImageDecoder::GenerateMipChain(ImageData& image)
+{
+	if (image.IsCompressed() || image.Levels.size() != 1)
+		return;
+
+	// 2x2 box filter, odd edges reuse their last texel
+	while (image.Levels.back().Width > 1 || image.Levels.back().Height > 1)
+	{
+		const ImageLevel& source = image.Levels.back();
+
+		ImageLevel level;
+		level.Width = std::max(source.Width / 2, 1u);
+		level.Height = std::max(source.Height / 2, 1u);
+		level.Data.resize(static_cast<size_t>(level.Width) * level.Height * 4);
+
+		for (uint32_t y = 0; y < level.Height; ++y)
+		{
+			const uint32_t y0 = std::min(y * 2, source.Height - 1);
+			const uint32_t y1 = std::min(y * 2 + 1, source.Height - 1);
+			for (uint32_t x = 0; x < level.Width; ++x)
+			{
+				const uint32_t x0 = std::min(x * 2, source.Width - 1);
+				const uint32_t x1 = std::min(x * 2 + 1, source.Width - 1);
+
+				const uint8_t* p00 = &source.Data[(static_cast<size_t>(y0) * source.Width + x0) * 4];
+				const uint8_t* p01 = &source.Data[(static_cast<size_t>(y0) * source.Width + x1) * 4];
+				const uint8_t* p10 = &source.Data[(static_cast<size_t>(y1) * source.Width + x0) * 4];
+				const uint8_t* p11 = &source.Data[(static_cast<size_t>(y1) * source.Width + x1) * 4];
+
+				uint8_t* output = &level.Data[(static_cast<size_t>(y) * level.Width + x) * 4];
+				for (uint32_t c = 0; c < 4; ++c)
+					output[c] = static_cast<uint8_t>((p00[c] + p01[c] + p10[c] + p11[c] + 2) / 4);
+			}
+		}
+		image.Levels.push_back(std::move(level));
+	}
+}
+
+bool ImageDecoder::FlipVertically(ImageData& image)
+{
+	// Either every level is flipped or none, a half flipped chain would be worse than an upside down one
+	for (const ImageLevel& level : image.Levels)
+	{
+		if (!CanFlipLevel(image.Format, level))
+			return false;
+	}
+
+	for (ImageLevel& level : image.Levels)
+		FlipLevel(image.Format, level);
+	return true;
+}
\ No newline at end of file
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "Textures/ImageData.h"
+
+struct ImageLoadOptions
+{
+public:
+	bool GenerateMips = true;
+	// Plain images are compressed on upload and the result is cached next to the source
+	bool Compress = true;
+};
+
+// Turns image files into upload ready data, safe to call from any thread.
+class ImageDecoder
+{
+public:
+	// Format plain images are compressed to on upload
+	static constexpr ImagePixelFormat CompressedFormat = ImagePixelFormat::BC3;
+public:
+	// Dds and ktx2 files are taken as stored, png and jpeg files are decoded and get their mip chain
+	// generated. With compression requested an up to date compressed copy next to the source is preferred.
+	static bool Load(const std::string& filepath, const ImageLoadOptions& options, ImageData& image, bool& fromCompressedCache);
+
+	static bool IsContainer(const std::string& filepath);
+	static std::string GetCompressedCachePath(const std::string& filepath);
+
+	static void GenerateMipChain(ImageData& image);
+
+	// Block compressed data is flipped block by block, returns false for formats that can't be
+	static bool FlipVertically(ImageData& image);
+};
\ No newline at end of file
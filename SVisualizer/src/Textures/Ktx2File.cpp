@@ -0,0 +1,120 @@
+#include "svis_pch.h"
+#include "Ktx2File.h"
+
+#include <cstring>
+
+static constexpr uint8_t Ktx2Identifier[12] = { 0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n' };
+
+struct Ktx2Header
+{
+	uint32_t VkFormat;
+	uint32_t TypeSize;
+	uint32_t PixelWidth;
+	uint32_t PixelHeight;
+	uint32_t PixelDepth;
+	uint32_t LayerCount;
+	uint32_t FaceCount;
+	uint32_t LevelCount;
+	uint32_t SupercompressionScheme;
+};
+
+// Follows the header, kept apart so neither struct needs padding
+struct Ktx2Index
+{
+	uint32_t DfdByteOffset;
+	uint32_t DfdByteLength;
+	uint32_t KvdByteOffset;
+	uint32_t KvdByteLength;
+	uint64_t SgdByteOffset;
+	uint64_t SgdByteLength;
+};
+
+struct Ktx2LevelIndex
+{
+	uint64_t ByteOffset;
+	uint64_t ByteLength;
+	uint64_t UncompressedByteLength;
+};
+
+static_assert(sizeof(Ktx2Header) == 36, "Unexpected ktx2 header size.");
+static_assert(sizeof(Ktx2Index) == 32, "Unexpected ktx2 index size.");
+
+// The srgb variants hold the same data, slots sample everything as linear like the png path
+static bool FormatFromVulkan(uint32_t vkFormat, ImagePixelFormat& format)
+{
+	switch (vkFormat)
+	{
+		case 37: case 43:					format = ImagePixelFormat::RGBA8;	return true;
+		case 131: case 132: case 133: case 134:	format = ImagePixelFormat::BC1;		return true;
+		case 137: case 138:					format = ImagePixelFormat::BC3;		return true;
+		case 139:							format = ImagePixelFormat::BC4;		return true;
+		case 141:							format = ImagePixelFormat::BC5;		return true;
+		case 145: case 146:					format = ImagePixelFormat::BC7;		return true;
+		default:
+			return false;
+	}
+}
+
+static bool Fail(std::string* error, const char* message)
+{
+	if (error)
+		*error = message;
+	return false;
+}
+
+bool Ktx2File::Read(const std::string& filepath, ImageData& image, std::string* error)
+{
+	std::ifstream stream(filepath, std::ios::binary);
+	if (!stream.good())
+		return Fail(error, "Unable to open file.");
+
+	uint8_t identifier[sizeof(Ktx2Identifier)];
+	Ktx2Header header;
+	Ktx2Index index;
+	stream.read(reinterpret_cast<char*>(identifier), sizeof(identifier));
+	stream.read(reinterpret_cast<char*>(&header), sizeof(header));
+	stream.read(reinterpret_cast<char*>(&index), sizeof(index));
+	if (!stream || std::memcmp(identifier, Ktx2Identifier, sizeof(Ktx2Identifier)) != 0)
+		return Fail(error, "Not a ktx2 file.");
+
+	if (header.PixelWidth == 0 || header.PixelHeight == 0 || header.PixelDepth > 1 || header.LayerCount > 1 || header.FaceCount != 1)
+		return Fail(error, "Only single 2d ktx2 images are supported.");
+
+	if (header.SupercompressionScheme != 0)
+		return Fail(error, "Supercompressed ktx2 files are not supported.");
+
+	ImagePixelFormat format = ImagePixelFormat::RGBA8;
+	if (!FormatFromVulkan(header.VkFormat, format))
+		return Fail(error, "Unsupported ktx2 format, expected BC1, BC3, BC4, BC5, BC7 or RGBA8.");
+
+	// A level count of zero asks the loader to generate the chain, only the base level is stored then
+	const uint32_t levelCount = std::max(header.LevelCount, 1u);
+	std::vector<Ktx2LevelIndex> levelIndex(levelCount);
+	stream.read(reinterpret_cast<char*>(levelIndex.data()), levelIndex.size() * sizeof(Ktx2LevelIndex));
+	if (!stream)
+		return Fail(error, "Truncated ktx2 file.");
+
+	image.Format = format;
+	image.Levels.clear();
+	image.Levels.reserve(levelCount);
+
+	for (uint32_t i = 0; i < levelCount; ++i)
+	{
+		ImageLevel level;
+		level.Width = std::max(header.PixelWidth >> i, 1u);
+		level.Height = std::max(header.PixelHeight >> i, 1u);
+
+		const size_t levelSize = ImageData::GetLevelSize(format, level.Width, level.Height);
+		if (levelIndex[i].ByteLength < levelSize)
+			return Fail(error, "Malformed ktx2 level index.");
+
+		level.Data.resize(levelSize);
+		stream.seekg(static_cast<std::streamoff>(levelIndex[i].ByteOffset));
+		stream.read(reinterpret_cast<char*>(level.Data.data()), level.Data.size());
+		if (!stream)
+			return Fail(error, "Truncated ktx2 file.");
+
+		image.Levels.push_back(std::move(level));
+	}
+	return true;
+}
\ No newline at end of file
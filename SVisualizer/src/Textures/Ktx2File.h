@@ -0,0 +1,12 @@
+#pragma once
+
+#include "Textures/ImageData.h"
+
+// Reads KTX 2.0 files holding a single 2d image with its mip chain in one of the block compressed
+// or 32-bit rgba formats the slots accept. Supercompressed (basis, zstd) files are not handled.
+class Ktx2File
+{
+public:
+	// Levels are returned as stored, which for ktx2 without an orientation override means top row first
+	static bool Read(const std::string& filepath, ImageData& image, std::string* error = nullptr);
+};
\ No newline at end of file
@@ -0,0 +1,167 @@
+#include "svis_pch.h"
+#include "SlotTexture.h"
+
+#include "Textures/ImageDecoder.h"
+
+#include <glad/glad.h>
+
+// Not part of the core profile headers, though every desktop driver exposes them
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT1_EXT 0x83F1
+#endif
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+
+static GLenum GetInternalFormat(ImagePixelFormat format)
+{
+	switch (format)
+	{
+		case ImagePixelFormat::BC1:	return GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
+		case ImagePixelFormat::BC3:	return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+		case ImagePixelFormat::BC4:	return GL_COMPRESSED_RED_RGTC1;
+		case ImagePixelFormat::BC5:	return GL_COMPRESSED_RG_RGTC2;
+		case ImagePixelFormat::BC7:	return GL_COMPRESSED_RGBA_BPTC_UNORM;
+		default:					return GL_RGBA8;
+	}
+}
+
+Elysium::Shared<SlotTexture> SlotTexture::Create(const ImageData& image, bool compress)
+{
+	if (!image.IsValid())
+		return nullptr;
+
+	Elysium::Shared<SlotTexture> texture(new SlotTexture());
+	texture->m_width = image.GetWidth();
+	texture->m_height = image.GetHeight();
+	texture->m_levelCount = static_cast<uint32_t>(image.Levels.size());
+
+	const bool compressOnUpload = compress && !image.IsCompressed();
+	texture->m_format = compressOnUpload ? ImageDecoder::CompressedFormat : image.Format;
+
+	GLuint rendererID = 0;
+	glCreateTextures(GL_TEXTURE_2D, 1, &rendererID);
+	texture->m_rendererID = rendererID;
+
+	glTextureStorage2D(rendererID, texture->m_levelCount, GetInternalFormat(texture->m_format), texture->m_width, texture->m_height);
+
+	for (uint32_t i = 0; i < texture->m_levelCount; ++i)
+	{
+		const ImageLevel& level = image.Levels[i];
+		if (image.IsCompressed())
+		{
+			glCompressedTextureSubImage2D(rendererID, i, 0, 0, level.Width, level.Height, GetInternalFormat(image.Format),
+										  static_cast<GLsizei>(level.Data.size()), level.Data.data());
+		}
+		else
+		{
+			// Whole levels only, so the driver is free to compress them block by block
+			glTextureSubImage2D(rendererID, i, 0, 0, level.Width, level.Height, GL_RGBA, GL_UNSIGNED_BYTE, level.Data.data());
+		}
+
+		texture->m_byteSize += ImageData::GetLevelSize(texture->m_format, level.Width, level.Height);
+	}
+
+	const bool mipmapped = texture->m_levelCount > 1;
+	glTextureParameteri(rendererID, GL_TEXTURE_MIN_FILTER, mipmapped ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+	glTextureParameteri(rendererID, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glTextureParameteri(rendererID, GL_TEXTURE_WRAP_S, GL_REPEAT);
+	glTextureParameteri(rendererID, GL_TEXTURE_WRAP_T, GL_REPEAT);
+
+	return texture;
+}
+
+Elysium::Shared<SlotTexture> SlotTexture::Create(uint32_t width, uint32_t height)
+{
+	Elysium::Shared<SlotTexture> texture(new SlotTexture());
+	texture->m_width = width;
+	texture->m_height = height;
+	texture->m_levelCount = 1;
+	texture->m_format = ImagePixelFormat::RGBA8;
+	texture->m_byteSize = ImageData::GetLevelSize(ImagePixelFormat::RGBA8, width, height);
+
+	GLuint rendererID = 0;
+	glCreateTextures(GL_TEXTURE_2D, 1, &rendererID);
+	texture->m_rendererID = rendererID;
+
+	glTextureStorage2D(rendererID, 1, GL_RGBA8, width, height);
+	glTextureParameteri(rendererID, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTextureParameteri(rendererID, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glTextureParameteri(rendererID, GL_TEXTURE_WRAP_S, GL_REPEAT);
+	glTextureParameteri(rendererID, GL_TEXTURE_WRAP_T, GL_REPEAT);
+
+	return texture;
+}
+
+SlotTexture::SlotTexture()
+	: m_rendererID(0),
+	m_width(0),
+	m_height(0),
+	m_levelCount(0),
+	m_format(ImagePixelFormat::RGBA8),
+	m_byteSize(0)
+{
+}
+
+SlotTexture::~SlotTexture()
+{
+	glDeleteTextures(1, &m_rendererID);
+}
+
+void SlotTexture::Bind(uint32_t unit) const
+{
+	glBindTextureUnit(unit, m_rendererID);
+}
+
+void SlotTexture::SetData(uint32_t bufferID, size_t offset)
+{
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, bufferID);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+	glTextureSubImage2D(m_rendererID, 0, 0, 0, m_width, m_height, GL_RGBA, GL_UNSIGNED_BYTE, reinterpret_cast<const void*>(offset));
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+}
+
+bool SlotTexture::QueueReadBack(uint32_t bufferID, ImageData& image) const
+{
+	image.Format = m_format;
+	image.Levels.clear();
+	image.Levels.reserve(m_levelCount);
+
+	size_t totalSize = 0;
+	for (uint32_t i = 0; i < m_levelCount; ++i)
+	{
+		ImageLevel level;
+		level.Width = std::max(m_width >> i, 1u);
+		level.Height = std::max(m_height >> i, 1u);
+		level.Data.resize(ImageData::GetLevelSize(m_format, level.Width, level.Height));
+
+		if (m_format != ImagePixelFormat::RGBA8)
+		{
+			GLint storedSize = 0;
+			glGetTextureLevelParameteriv(m_rendererID, i, GL_TEXTURE_COMPRESSED_IMAGE_SIZE, &storedSize);
+			if (static_cast<size_t>(storedSize) != level.Data.size())
+				return false;
+		}
+
+		totalSize += level.Data.size();
+		image.Levels.push_back(std::move(level));
+	}
+
+	glNamedBufferData(bufferID, static_cast<GLsizeiptr>(totalSize), nullptr, GL_STREAM_READ);
+
+	// The copies land in the pack buffer, returning immediately
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, bufferID);
+	size_t offset = 0;
+	for (uint32_t i = 0; i < m_levelCount; ++i)
+	{
+		const GLsizei levelSize = static_cast<GLsizei>(image.Levels[i].Data.size());
+		void* destination = reinterpret_cast<void*>(offset);
+		if (m_format == ImagePixelFormat::RGBA8)
+			glGetTextureImage(m_rendererID, i, GL_RGBA, GL_UNSIGNED_BYTE, levelSize, destination);
+		else
+			glGetCompressedTextureImage(m_rendererID, i, levelSize, destination);
+		offset += levelSize;
+	}
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+	return true;
+}
\ No newline at end of file
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "Elysium.h"
+
+#include "Textures/ImageData.h"
+
+// Texture owned by the application rather than the engine, whose Texture2D holds a single
+// uncompressed level. Slot images need full mip chains and block compressed storage.
+class SlotTexture
+{
+public:
+	// Uploads every level of the image. With compress set, uncompressed images are handed to
+	// the driver as ImageDecoder::CompressedFormat and compressed while uploading.
+	static Elysium::Shared<SlotTexture> Create(const ImageData& image, bool compress);
+	// Single uncompressed level whose contents arrive later through SetData, used for streamed frames
+	static Elysium::Shared<SlotTexture> Create(uint32_t width, uint32_t height);
+public:
+	SlotTexture(const SlotTexture&) = delete;
+	SlotTexture& operator=(const SlotTexture&) = delete;
+	~SlotTexture();
+public:
+	void Bind(uint32_t unit) const;
+
+	// Replaces the base level with tightly packed RGBA8 rows read from a pixel unpack buffer
+	void SetData(uint32_t bufferID, size_t offset);
+
+	// Queues a copy of the stored levels into a pixel pack buffer, back to back in level order, used
+	// to cache what the driver compressed. The image gets levels sized to take the data once it arrived.
+	bool QueueReadBack(uint32_t bufferID, ImageData& image) const;
+
+	inline uint32_t GetRendererID() const { return m_rendererID; }
+	inline uint32_t GetWidth() const { return m_width; }
+	inline uint32_t GetHeight() const { return m_height; }
+	inline uint32_t GetLevelCount() const { return m_levelCount; }
+	inline ImagePixelFormat GetFormat() const { return m_format; }
+	inline uint64_t GetByteSize() const { return m_byteSize; }
+private:
+	SlotTexture();
+private:
+	uint32_t m_rendererID;
+	uint32_t m_width;
+	uint32_t m_height;
+	uint32_t m_levelCount;
+	ImagePixelFormat m_format;
+	uint64_t m_byteSize;
+};
\ No newline at end of file
@@ -0,0 +1,158 @@
+#include "svis_pch.h"
+#include "TextureCache.h"
+
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+struct TextureCacheEntry
+{
+	Elysium::Shared<SlotTexture> Texture;
+	uint64_t Bytes = 0;
+	uint64_t LastUsed = 0;
+};
+
+struct TextureCacheData
+{
+	std::unordered_map<std::string, TextureCacheEntry> Entries;
+	uint64_t Budget = TextureCache::DefaultBudget;
+	uint64_t ResidentBytes = 0;
+
+	// Monotonic use counter standing in for a timestamp
+	uint64_t UseCounter = 0;
+
+	uint32_t Hits = 0;
+	uint32_t Misses = 0;
+	uint32_t Evictions = 0;
+};
+
+static TextureCacheData s_data;
+
+static bool IsReferenced(const TextureCacheEntry& entry)
+{
+	return entry.Texture.use_count() > 1;
+}
+
+static void EraseEntry(std::unordered_map<std::string, TextureCacheEntry>::iterator it)
+{
+	s_data.ResidentBytes -= std::min(it->second.Bytes, s_data.ResidentBytes);
+	s_data.Entries.erase(it);
+}
+
+void TextureCache::Shutdown()
+{
+	s_data.Entries.clear();
+	s_data.ResidentBytes = 0;
+}
+
+std::string TextureCache::MakeKey(const std::string& filepath)
+{
+	std::error_code error;
+	const fs::path canonicalPath = fs::weakly_canonical(filepath, error);
+	if (error)
+		return std::string();
+
+	const fs::file_time_type writeTime = fs::last_write_time(canonicalPath, error);
+	if (error)
+		return std::string();
+
+	std::stringstream key;
+	key << canonicalPath.string() << '|' << writeTime.time_since_epoch().count();
+	return key.str();
+}
+
+Elysium::Shared<SlotTexture> TextureCache::Find(const std::string& key)
+{
+	auto found = s_data.Entries.find(key);
+	if (found == s_data.Entries.end())
+	{
+		++s_data.Misses;
+		return nullptr;
+	}
+
+	++s_data.Hits;
+	found->second.LastUsed = ++s_data.UseCounter;
+	return found->second.Texture;
+}
+
+void TextureCache::Insert(const std::string& key, const Elysium::Shared<SlotTexture>& texture, uint64_t bytes)
+{
+	if (key.empty() || texture == nullptr)
+		return;
+
+	auto found = s_data.Entries.find(key);
+	if (found != s_data.Entries.end())
+		EraseEntry(found);
+
+	TextureCacheEntry entry;
+	entry.Texture = texture;
+	entry.Bytes = bytes;
+	entry.LastUsed = ++s_data.UseCounter;
+	s_data.Entries.emplace(key, std::move(entry));
+	s_data.ResidentBytes += bytes;
+
+	Trim();
+}
+
+void TextureCache::Trim()
+{
+	while (s_data.ResidentBytes > s_data.Budget)
+	{
+		// Textures still bound to a slot can't be freed, so the oldest unused one goes
+		auto oldest = s_data.Entries.end();
+		for (auto it = s_data.Entries.begin(); it != s_data.Entries.end(); ++it)
+		{
+			if (!IsReferenced(it->second) && (oldest == s_data.Entries.end() || it->second.LastUsed < oldest->second.LastUsed))
+				oldest = it;
+		}
+
+		if (oldest == s_data.Entries.end())
+			break;
+
+		EraseEntry(oldest);
+		++s_data.Evictions;
+	}
+}
+
+void TextureCache::ClearUnused()
+{
+	for (auto it = s_data.Entries.begin(); it != s_data.Entries.end();)
+	{
+		if (IsReferenced(it->second))
+		{
+			++it;
+			continue;
+		}
+
+		s_data.ResidentBytes -= std::min(it->second.Bytes, s_data.ResidentBytes);
+		it = s_data.Entries.erase(it);
+	}
+}
+
+uint64_t TextureCache::GetBudget()
+{
+	return s_data.Budget;
+}
+
+void TextureCache::SetBudget(uint64_t budget)
+{
+	s_data.Budget = budget;
+	Trim();
+}
+
+TextureCache::Statistics TextureCache::GetStatistics()
+{
+	Statistics stats;
+	stats.Hits = s_data.Hits;
+	stats.Misses = s_data.Misses;
+	stats.Evictions = s_data.Evictions;
+	stats.EntryCount = static_cast<uint32_t>(s_data.Entries.size());
+	stats.ResidentBytes = s_data.ResidentBytes;
+
+	for (const auto& [key, entry] : s_data.Entries)
+	{
+		if (IsReferenced(entry))
+			++stats.ReferencedCount;
+	}
+	return stats;
+}
\ No newline at end of file
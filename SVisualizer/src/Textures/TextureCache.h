@@ -0,0 +1,50 @@
+#pragma once
+
+#include "Elysium.h"
+
+#include "Textures/SlotTexture.h"
+
+#include <string>
+
+// Keeps uploaded images around so the same file is decoded and uploaded once, no matter how many
+// slots or package reloads use it. Entries are keyed by canonical path and modification time, so
+// an edited file is loaded fresh. A texture is in use while anyone besides the cache holds it,
+// unused ones are evicted least recently used first once the cache grows past its budget.
+// Only used from the render thread.
+class TextureCache
+{
+public:
+	static constexpr uint64_t DefaultBudget = 512ull * 1024ull * 1024ull;
+public:
+	struct Statistics
+	{
+	public:
+		uint32_t Hits = 0;
+		uint32_t Misses = 0;
+		uint32_t Evictions = 0;
+
+		uint32_t EntryCount = 0;
+		uint32_t ReferencedCount = 0;
+		uint64_t ResidentBytes = 0;
+	};
+public:
+	// Releases every texture, has to happen while the context is still alive
+	static void Shutdown();
+
+	// Identifies the current contents of a file, empty if it doesn't exist
+	static std::string MakeKey(const std::string& filepath);
+
+	// Counts a hit or a miss
+	static Elysium::Shared<SlotTexture> Find(const std::string& key);
+	static void Insert(const std::string& key, const Elysium::Shared<SlotTexture>& texture, uint64_t bytes);
+
+	// Evicts unused entries until the cache fits its budget again
+	static void Trim();
+	// Drops every unused entry
+	static void ClearUnused();
+
+	static uint64_t GetBudget();
+	static void SetBudget(uint64_t budget);
+
+	static Statistics GetStatistics();
+};
\ No newline at end of file
@@ -0,0 +1,465 @@
+#include "svis_pch.h"
+#include "VideoStream.h"
+
+#include "Rendering/RenderStateCache.h"
+
+#include <glad/glad.h>
+#include <opencv2/opencv.hpp>
+
+#include <filesystem>
+
+// Short jumps ahead are read through rather than seeking, which has to restart at the previous keyframe
+static constexpr int64_t MaxFramesSkipped = 8;
+
+static const char* const s_videoExtensions[] = { ".mp4", ".m4v", ".mov", ".avi", ".mkv", ".webm", ".wmv", ".mpg", ".mpeg" };
+
+bool VideoStream::IsStreamPath(const std::string& filepath)
+{
+	const std::filesystem::path path(filepath);
+	if (path.filename().string().find('%') != std::string::npos)
+		return true;
+
+	std::string extension = path.extension().string();
+	std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+	for (const char* videoExtension : s_videoExtensions)
+	{
+		if (extension == videoExtension)
+			return true;
+	}
+	return false;
+}
+
+std::string VideoStream::MakeSequencePattern(const std::string& frameFilepath)
+{
+	const std::filesystem::path path(frameFilepath);
+	const std::string stem = path.stem().string();
+
+	// The frame number is the last run of digits in the name
+	const size_t digitsEnd = stem.find_last_of("0123456789");
+	if (digitsEnd == std::string::npos)
+		return "";
+	const size_t digitsBegin = stem.find_last_not_of("0123456789", digitsEnd);
+	const size_t numberBegin = digitsBegin == std::string::npos ? 0 : digitsBegin + 1;
+	const size_t digitCount = digitsEnd + 1 - numberBegin;
+
+	const std::string pattern = stem.substr(0, numberBegin) + "%0" + std::to_string(digitCount) + "d" + stem.substr(digitsEnd + 1);
+	return (path.parent_path() / (pattern + path.extension().string())).string();
+}
+
+bool VideoStream::ReadFrame(const std::string& filepath, float time, ImageData& image)
+{
+	cv::VideoCapture capture;
+	if (!capture.open(filepath) || !capture.isOpened())
+		return false;
+
+	const double reportedFrameRate = capture.get(cv::CAP_PROP_FPS);
+	const double frameRate = reportedFrameRate > 0.0 && reportedFrameRate < 1000.0 ? reportedFrameRate : DefaultFrameRate;
+	const int64_t frameCount = static_cast<int64_t>(capture.get(cv::CAP_PROP_FRAME_COUNT));
+
+	int64_t frame = std::max<int64_t>(0, static_cast<int64_t>(std::floor(time * frameRate)));
+	if (frameCount > 0)
+		frame %= frameCount;
+	if (frame > 0)
+		capture.set(cv::CAP_PROP_POS_FRAMES, static_cast<double>(frame));
+
+	cv::Mat decoded;
+	if (!capture.read(decoded) || decoded.empty())
+		return false;
+
+	int conversion = cv::COLOR_BGR2RGBA;
+	if (decoded.channels() == 1)
+		conversion = cv::COLOR_GRAY2RGBA;
+	else if (decoded.channels() == 4)
+		conversion = cv::COLOR_BGRA2RGBA;
+
+	ImageLevel level;
+	level.Width = static_cast<uint32_t>(decoded.cols);
+	level.Height = static_cast<uint32_t>(decoded.rows);
+	level.Data.resize(static_cast<size_t>(level.Width) * level.Height * 4);
+
+	cv::Mat frameData(decoded.rows, decoded.cols, CV_8UC4, level.Data.data());
+	cv::cvtColor(decoded, frameData, conversion);
+	cv::flip(frameData, frameData, 0);
+
+	image.Format = ImagePixelFormat::RGBA8;
+	image.Levels.clear();
+	image.Levels.push_back(std::move(level));
+	return true;
+}
+
+VideoStream::SlotFrames VideoStream::ReadSlotFrames(const std::array<std::string, ShaderPackage::MaxTextureSlots>& slots, float time)
+{
+	SlotFrames frames;
+	for (uint8_t i = 0; i < ShaderPackage::MaxTextureSlots; ++i)
+	{
+		if (!IsStreamPath(slots[i]))
+			continue;
+
+		ImageData image;
+		if (ReadFrame(slots[i], time, image))
+			frames[i] = SlotTexture::Create(image, false);
+		else
+			ELYSIUM_WARN("Export Uses the Last Shown Frame of Slot {0}: {1}", i, slots[i]);
+	}
+	return frames;
+}
+
+void VideoStream::BindSlotFrames(const SlotFrames& frames)
+{
+	for (uint8_t i = 0; i < ShaderPackage::MaxTextureSlots; ++i)
+	{
+		if (frames[i] != nullptr)
+			RenderStateCache::BindTexture(ShaderPackage::FirstTextureUnit + i, frames[i]);
+	}
+}
+
+VideoStream::VideoStream(const std::string& filepath)
+	: m_filepath(filepath),
+	m_capture(nullptr),
+	m_decodePosition(0),
+	m_opened(false),
+	m_width(0),
+	m_height(0),
+	m_frameRate(DefaultFrameRate),
+	m_frameBytes(0),
+	m_texture(nullptr),
+	m_bufferID(0),
+	m_firstFrameShown(false),
+	m_mappedRing(nullptr),
+	m_targetFrame(0),
+	m_shownFrame(-1),
+	m_frameCount(0),
+	m_failed(false),
+	m_stopping(false)
+{
+	m_worker = std::thread(&VideoStream::WorkerLoop, this);
+}
+
+VideoStream::~VideoStream()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stopping = true;
+	}
+	m_condition.notify_all();
+
+	// The worker may still be writing into the mapped ring
+	if (m_worker.joinable())
+		m_worker.join();
+
+	for (RingBuffer& buffer : m_ring)
+	{
+		if (buffer.Fence != nullptr)
+			glDeleteSync(static_cast<GLsync>(buffer.Fence));
+	}
+
+	if (m_bufferID != 0)
+	{
+		if (m_mappedRing != nullptr)
+			glUnmapNamedBuffer(m_bufferID);
+		glDeleteBuffers(1, &m_bufferID);
+	}
+}
+
+bool VideoStream::Update(float time)
+{
+	if (!m_opened.load(std::memory_order_acquire) || HasFailed())
+		return false;
+
+	if (m_texture == nullptr)
+		CreateRing();
+
+	const int64_t targetFrame = std::max<int64_t>(0, static_cast<int64_t>(std::floor(time * m_frameRate)));
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	RetireUploads();
+
+	// Going back in time starts the dropped frame count over
+	if (targetFrame < m_shownFrame)
+		m_shownFrame = -1;
+	const bool targetChanged = targetFrame != m_targetFrame;
+	m_targetFrame = targetFrame;
+
+	// Show the newest frame that is due
+	int32_t newestIndex = -1;
+	for (uint32_t i = 0; i < RingSize; ++i)
+	{
+		const RingBuffer& buffer = m_ring[i];
+		if (buffer.State == BufferState::Ready && buffer.Frame <= targetFrame && buffer.Frame > m_shownFrame &&
+			(newestIndex < 0 || buffer.Frame > m_ring[newestIndex].Frame))
+			newestIndex = static_cast<int32_t>(i);
+	}
+
+	// Older frames were passed over or already shown, and frames far ahead were decoded before a seek
+	bool released = false;
+	for (uint32_t i = 0; i < RingSize; ++i)
+	{
+		RingBuffer& buffer = m_ring[i];
+		if (buffer.State != BufferState::Ready || static_cast<int32_t>(i) == newestIndex)
+			continue;
+
+		if (buffer.Frame < targetFrame || buffer.Frame <= m_shownFrame || buffer.Frame >= targetFrame + RingSize)
+		{
+			buffer.State = BufferState::Free;
+			buffer.Frame = -1;
+			released = true;
+		}
+	}
+
+	if (released || targetChanged)
+		m_condition.notify_one();
+
+	if (newestIndex < 0)
+		return false;
+
+	RingBuffer& buffer = m_ring[newestIndex];
+	m_texture->SetData(m_bufferID, newestIndex * m_frameBytes);
+
+	// The worker gets the buffer back once the copy has been executed
+	buffer.Fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	buffer.State = BufferState::Uploading;
+
+	if (m_shownFrame >= 0 && buffer.Frame > m_shownFrame + 1)
+		m_statistics.DroppedFrames += buffer.Frame - m_shownFrame - 1;
+	m_shownFrame = buffer.Frame;
+	++m_statistics.FramesShown;
+	m_firstFrameShown = true;
+	return true;
+}
+
+bool VideoStream::HasFailed() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_failed;
+}
+
+int64_t VideoStream::GetFrameCount() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_frameCount;
+}
+
+VideoStream::Statistics VideoStream::GetStatistics() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_statistics;
+}
+
+void VideoStream::WorkerLoop()
+{
+	if (!OpenSource())
+	{
+		ELYSIUM_WARN("Failed to Open Video Stream: {0}", m_filepath);
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_failed = true;
+		return;
+	}
+
+	std::unique_lock<std::mutex> lock(m_mutex);
+	while (true)
+	{
+		int64_t frame = 0;
+		uint32_t bufferIndex = 0;
+		m_condition.wait(lock, [&]() { return m_stopping || m_failed || FindWork(frame, bufferIndex); });
+		if (m_stopping || m_failed)
+			break;
+
+		RingBuffer& buffer = m_ring[bufferIndex];
+		buffer.State = BufferState::Decoding;
+		buffer.Frame = frame;
+		uint8_t* destination = m_mappedRing + bufferIndex * m_frameBytes;
+		lock.unlock();
+
+		const std::chrono::steady_clock::time_point decodeStart = std::chrono::steady_clock::now();
+		const bool decoded = DecodeFrame(frame, destination);
+		const float decodeMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - decodeStart).count();
+
+		lock.lock();
+		if (!decoded)
+		{
+			buffer.State = BufferState::Free;
+			buffer.Frame = -1;
+			continue;
+		}
+
+		buffer.State = BufferState::Ready;
+
+		++m_statistics.FramesDecoded;
+		m_statistics.LastDecodeMs = decodeMs;
+		m_statistics.AverageDecodeMs += (decodeMs - m_statistics.AverageDecodeMs) / static_cast<float>(m_statistics.FramesDecoded);
+	}
+
+	m_capture = nullptr;
+}
+
+bool VideoStream::OpenSource()
+{
+	m_capture = Elysium::CreateUnique<cv::VideoCapture>();
+	if (!m_capture->open(m_filepath) || !m_capture->isOpened())
+		return false;
+
+	int width = static_cast<int>(m_capture->get(cv::CAP_PROP_FRAME_WIDTH));
+	int height = static_cast<int>(m_capture->get(cv::CAP_PROP_FRAME_HEIGHT));
+
+	// Image sequences only know their size once a frame has been read
+	if (width <= 0 || height <= 0)
+	{
+		cv::Mat firstFrame;
+		if (!m_capture->read(firstFrame) || firstFrame.empty())
+			return false;
+
+		width = firstFrame.cols;
+		height = firstFrame.rows;
+		m_decodePosition = 1;
+	}
+
+	const double frameRate = m_capture->get(cv::CAP_PROP_FPS);
+	m_frameRate = frameRate > 0.0 && frameRate < 1000.0 ? frameRate : DefaultFrameRate;
+	m_width = static_cast<uint32_t>(width);
+	m_height = static_cast<uint32_t>(height);
+	m_frameBytes = static_cast<size_t>(m_width) * m_height * 4;
+
+	const int64_t frameCount = static_cast<int64_t>(m_capture->get(cv::CAP_PROP_FRAME_COUNT));
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_frameCount = std::max<int64_t>(frameCount, 0);
+	}
+
+	m_opened.store(true, std::memory_order_release);
+	return true;
+}
+
+bool VideoStream::FindWork(int64_t& frame, uint32_t& bufferIndex) const
+{
+	if (m_mappedRing == nullptr)
+		return false;
+
+	// The earliest frame of the window ahead that nobody holds yet, the one on screen isn't needed again
+	for (int64_t candidate = std::max(m_targetFrame, m_shownFrame + 1); candidate < m_targetFrame + RingSize; ++candidate)
+	{
+		bool held = false;
+		for (const RingBuffer& buffer : m_ring)
+			held |= buffer.State != BufferState::Free && buffer.Frame == candidate;
+		if (held)
+			continue;
+
+		for (uint32_t i = 0; i < RingSize; ++i)
+		{
+			if (m_ring[i].State == BufferState::Free)
+			{
+				frame = candidate;
+				bufferIndex = i;
+				return true;
+			}
+		}
+		return false;
+	}
+	return false;
+}
+
+bool VideoStream::DecodeFrame(int64_t frame, uint8_t* destination)
+{
+	int64_t frameCount = 0;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		frameCount = m_frameCount;
+	}
+
+	// Playback loops, the frame counter itself keeps growing
+	const int64_t position = frameCount > 0 ? frame % frameCount : frame;
+	if (position != m_decodePosition)
+	{
+		if (m_decodePosition >= 0 && position > m_decodePosition && position - m_decodePosition <= MaxFramesSkipped)
+		{
+			while (m_decodePosition < position && m_capture->grab())
+				++m_decodePosition;
+		}
+		else
+		{
+			m_capture->set(cv::CAP_PROP_POS_FRAMES, static_cast<double>(position));
+			m_decodePosition = position;
+		}
+	}
+
+	cv::Mat decoded;
+	if (m_decodePosition != position || !m_capture->read(decoded) || decoded.empty())
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		// Ran off the end of the source, which either didn't report its length or reported too many frames
+		if (position == 0)
+			m_failed = true;
+		else if (m_frameCount == 0 || position < m_frameCount)
+			m_frameCount = position;
+
+		// Forces a seek for the next frame
+		m_decodePosition = -1;
+		return false;
+	}
+	++m_decodePosition;
+
+	// Frames of a sequence don't have to share a size
+	if (decoded.cols != static_cast<int>(m_width) || decoded.rows != static_cast<int>(m_height))
+		cv::resize(decoded, decoded, cv::Size(m_width, m_height), 0.0, 0.0, cv::INTER_AREA);
+
+	int conversion = cv::COLOR_BGR2RGBA;
+	if (decoded.channels() == 1)
+		conversion = cv::COLOR_GRAY2RGBA;
+	else if (decoded.channels() == 4)
+		conversion = cv::COLOR_BGRA2RGBA;
+
+	// Converted straight into the mapped buffer
+	cv::Mat frameData(m_height, m_width, CV_8UC4, destination);
+	cv::cvtColor(decoded, frameData, conversion);
+
+	// Gl rows start at the bottom of the image
+	cv::flip(frameData, frameData, 0);
+	return true;
+}
+
+void VideoStream::CreateRing()
+{
+	m_texture = SlotTexture::Create(m_width, m_height);
+
+	const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+	const GLsizeiptr ringBytes = static_cast<GLsizeiptr>(m_frameBytes * RingSize);
+
+	glCreateBuffers(1, &m_bufferID);
+	glNamedBufferStorage(m_bufferID, ringBytes, nullptr, flags);
+	void* mapped = glMapNamedBufferRange(m_bufferID, 0, ringBytes, flags);
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_mappedRing = static_cast<uint8_t*>(mapped);
+		if (m_mappedRing == nullptr)
+		{
+			ELYSIUM_WARN("Failed to Map the Upload Ring of Video Stream: {0}", m_filepath);
+			m_failed = true;
+		}
+	}
+	m_condition.notify_one();
+}
+
+void VideoStream::RetireUploads()
+{
+	bool released = false;
+	for (RingBuffer& buffer : m_ring)
+	{
+		if (buffer.State != BufferState::Uploading)
+			continue;
+
+		const GLenum status = glClientWaitSync(static_cast<GLsync>(buffer.Fence), 0, 0);
+		if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED)
+			continue;
+
+		glDeleteSync(static_cast<GLsync>(buffer.Fence));
+		buffer.Fence = nullptr;
+		buffer.State = BufferState::Free;
+		buffer.Frame = -1;
+		released = true;
+	}
+
+	if (released)
+		m_condition.notify_one();
+}
\ No newline at end of file
@@ -0,0 +1,126 @@
+#pragma once
+
+#include "Elysium.h"
+
+#include "ShaderPackage.h"
+#include "Textures/SlotTexture.h"
+
+namespace cv { class VideoCapture; }
+
+// Streams the frames of a video file or a numbered image sequence into a slot texture, in step
+// with the playback time. A worker thread decodes the frames ahead of the one on screen straight
+// into a ring of persistently mapped upload buffers, the render thread only copies a finished one
+// into the texture. Buffers are handed back to the worker once the copy's fence has signalled, so
+// neither side ever waits on the other. Playback loops once the last frame has been shown.
+class VideoStream
+{
+public:
+	// Frames decoded ahead of the one on screen
+	static constexpr uint32_t RingSize = 4;
+	// Image sequences carry no timing of their own
+	static constexpr double DefaultFrameRate = 30.0;
+public:
+	struct Statistics
+	{
+	public:
+		uint64_t FramesDecoded = 0;
+		uint64_t FramesShown = 0;
+		// Frames the playback time passed over before they were decoded
+		uint64_t DroppedFrames = 0;
+
+		float LastDecodeMs = 0.0f;
+		float AverageDecodeMs = 0.0f;
+	};
+public:
+	// Video files by extension, image sequences by a printf style frame number ("frame_%04d.png")
+	static bool IsStreamPath(const std::string& filepath);
+	// Turns one frame of a numbered sequence into the pattern matching all of them, empty if the name has no number
+	static std::string MakeSequencePattern(const std::string& frameFilepath);
+
+	// Decodes the single frame due at the given time, for one-off renders that have no use for a stream
+	static bool ReadFrame(const std::string& filepath, float time, ImageData& image);
+
+	// Frames due at an export's time for every streamed slot of a package, empty for other slots
+	using SlotFrames = std::array<Elysium::Shared<SlotTexture>, ShaderPackage::MaxTextureSlots>;
+	static SlotFrames ReadSlotFrames(const std::array<std::string, ShaderPackage::MaxTextureSlots>& slots, float time);
+	// Binds the frames in place of the streams' own textures, until the slots are bound again
+	static void BindSlotFrames(const SlotFrames& frames);
+public:
+	// Opens the source on the worker, frames follow once the first Update has seen it open
+	VideoStream(const std::string& filepath);
+	~VideoStream();
+public:
+	// Uploads the newest decoded frame at or before the given time, has to be called on the render thread.
+	// Returns whether the texture received a new frame.
+	bool Update(float time);
+
+	// Null until the first frame has arrived
+	inline Elysium::Shared<SlotTexture> GetTexture() const { return m_firstFrameShown ? m_texture : nullptr; }
+
+	// The source couldn't be opened or decoded
+	bool HasFailed() const;
+
+	// Valid once the texture exists
+	inline double GetFrameRate() const { return m_frameRate; }
+	// Zero while unknown
+	int64_t GetFrameCount() const;
+
+	Statistics GetStatistics() const;
+private:
+	enum class BufferState : uint8_t
+	{
+		Free,		// Ready for the worker
+		Decoding,	// Being written by the worker
+		Ready,		// Holds a decoded frame
+		Uploading	// Read by a texture copy still in flight
+	};
+
+	struct RingBuffer
+	{
+	public:
+		BufferState State = BufferState::Free;
+		int64_t Frame = -1;
+		void* Fence = nullptr;
+	};
+private:
+	void WorkerLoop();
+	bool OpenSource();
+	bool FindWork(int64_t& frame, uint32_t& bufferIndex) const;
+	bool DecodeFrame(int64_t frame, uint8_t* destination);
+
+	void CreateRing();
+	void RetireUploads();
+private:
+	std::string m_filepath;
+
+	// Decoder state, only touched by the worker
+	Elysium::Unique<cv::VideoCapture> m_capture;
+	int64_t m_decodePosition;
+
+	// Fixed once the worker has opened the source
+	std::atomic<bool> m_opened;
+	uint32_t m_width;
+	uint32_t m_height;
+	double m_frameRate;
+	size_t m_frameBytes;
+
+	// Render thread resources
+	Elysium::Shared<SlotTexture> m_texture;
+	uint32_t m_bufferID;
+	bool m_firstFrameShown;
+
+	mutable std::mutex m_mutex;
+	std::condition_variable m_condition;
+	std::thread m_worker;
+
+	// Guarded by the mutex
+	std::array<RingBuffer, RingSize> m_ring;
+	uint8_t* m_mappedRing;
+	int64_t m_targetFrame;
+	int64_t m_shownFrame;
+	// Unknown for some containers until the decoder runs off the end
+	int64_t m_frameCount;
+	bool m_failed;
+	bool m_stopping;
+	Statistics m_statistics;
+};
\ No newline at end of file
@@ -5,6 +5,11 @@
 #include <utility>
 #include <algorithm>
 #include <functional>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
 
 #include <string>
 #include <sstream>
@@ -12,5 +17,6 @@
 #include <vector>
 #include <array>
 #include <stack>
+#include <deque>
 #include <unordered_map>
 #include <unordered_set>
\ No newline at end of file
@@ -0,0 +1,77 @@
+include "Elysium/elysiumlink.lua"
+include "../SVisualizer/vendor/opencv_lib/opencv4link.lua"
+
+-- Headless renderer sharing the package, compile and render code of the editor
+project "SVisualizerCLI"
+	kind "ConsoleApp"
+
+	language "C++"
+	cppdialect "C++17"
+
+	staticruntime "on"
+
+	targetdir ("%{wks.location}/Binaries/" .. outputdir .. "/%{prj.name}")
+	objdir ("%{wks.location}/Intermediates/" .. outputdir .. "/%{prj.name}")
+
+	pchheader "svis_pch.h"
+	pchsource "../SVisualizer/src/svis_pch.cpp"
+
+	files
+	{
+		"src/**.h",
+		"src/**.cpp",
+
+		"../SVisualizer/src/svis_pch.h",
+		"../SVisualizer/src/svis_pch.cpp",
+		"../SVisualizer/src/ShaderPackage.h",
+		"../SVisualizer/src/ShaderPackageSerializer.h",
+		"../SVisualizer/src/ShaderPackageSerializer.cpp",
+		"../SVisualizer/src/ShaderPackageCompiler.h",
+		"../SVisualizer/src/ShaderPackageCompiler.cpp",
+		"../SVisualizer/src/Rendering/**.h",
+		"../SVisualizer/src/Rendering/**.cpp",
+		"../SVisualizer/src/Profiling/**.h",
+		"../SVisualizer/src/Profiling/**.cpp",
+		"../SVisualizer/src/Textures/ImageData.h",
+		"../SVisualizer/src/Textures/DdsFile.h",
+		"../SVisualizer/src/Textures/DdsFile.cpp",
+		"../SVisualizer/src/Textures/Ktx2File.h",
+		"../SVisualizer/src/Textures/Ktx2File.cpp",
+		"../SVisualizer/src/Textures/ImageDecoder.h",
+		"../SVisualizer/src/Textures/ImageDecoder.cpp",
+		"../SVisualizer/src/Textures/SlotTexture.h",
+		"../SVisualizer/src/Textures/SlotTexture.cpp",
+		"../SVisualizer/src/Textures/VideoStream.h",
+		"../SVisualizer/src/Textures/VideoStream.cpp"
+	}
+
+	includedirs
+	{
+		"src",
+		"../SVisualizer/src",
+
+		"%{IncludeDir.glad}",
+		"%{IncludeDir.entt}",
+		"%{IncludeDir.stduuid}",
+		"%{IncludeDir.stb_image}",
+		"%{IncludeDir.yaml_cpp}",
+		"%{IncludeDir.spd_log}"
+	}
+
+	LinkElysium()
+	LinkOpenCV4()
+
+	links
+	{
+		"EGL"
+	}
+
+	filter "configurations:Debug"
+		defines "ELYSIUM_DEBUG"
+		symbols "On"
+	filter "configurations:Release"
+		defines "ELYSIUM_RELEASE"
+		optimize "On"
+	filter "configurations:Dist"
+		defines "ELYSIUM_DIST"
+		optimize "Full"
\ No newline at end of file
@@ -0,0 +1,128 @@
+#include "svis_pch.h"
+#include "HeadlessContext.h"
+
+#include "Elysium.h"
+
+#include <glad/glad.h>
+
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+static constexpr EGLint ContextMajorVersion = 4;
+static constexpr EGLint ContextMinorVersion = 5;
+
+static EGLDisplay GetHeadlessDisplay()
+{
+	// Surfaceless needs neither a window system nor a render node, which allows llvmpipe fallbacks
+	PFNEGLGETPLATFORMDISPLAYEXTPROC getPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(eglGetProcAddress("eglGetPlatformDisplayEXT"));
+	if (getPlatformDisplay)
+	{
+		EGLDisplay display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+		if (display != EGL_NO_DISPLAY)
+			return display;
+	}
+	return eglGetDisplay(EGL_DEFAULT_DISPLAY);
+}
+
+HeadlessContext::HeadlessContext()
+	: m_display(nullptr),
+	m_context(nullptr),
+	m_rendererInitialized(false)
+{
+}
+
+HeadlessContext::~HeadlessContext()
+{
+	Destroy();
+}
+
+bool HeadlessContext::Create()
+{
+	EGLDisplay display = GetHeadlessDisplay();
+	EGLint major = 0, minor = 0;
+	if (display == EGL_NO_DISPLAY || !eglInitialize(display, &major, &minor))
+	{
+		ELYSIUM_ERROR("Failed to Initialize EGL Display.");
+		return false;
+	}
+	m_display = display;
+
+	if (!eglBindAPI(EGL_OPENGL_API))
+	{
+		ELYSIUM_ERROR("EGL Display Does Not Support Desktop OpenGL.");
+		Destroy();
+		return false;
+	}
+
+	// All rendering goes to framebuffer objects, so the config needs no surface type
+	const EGLint configAttributes[] = {
+		EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+		EGL_NONE
+	};
+	EGLConfig config = nullptr;
+	EGLint configCount = 0;
+	if (!eglChooseConfig(display, configAttributes, &config, 1, &configCount) || configCount == 0)
+	{
+		ELYSIUM_ERROR("No Suitable EGL Config Found.");
+		Destroy();
+		return false;
+	}
+
+	const EGLint contextAttributes[] = {
+		EGL_CONTEXT_MAJOR_VERSION, ContextMajorVersion,
+		EGL_CONTEXT_MINOR_VERSION, ContextMinorVersion,
+		EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+		EGL_NONE
+	};
+	EGLContext context = eglCreateContext(display, config, EGL_NO_CONTEXT, contextAttributes);
+	if (context == EGL_NO_CONTEXT)
+	{
+		ELYSIUM_ERROR("Failed to Create OpenGL {0}.{1} Context.", ContextMajorVersion, ContextMinorVersion);
+		Destroy();
+		return false;
+	}
+	m_context = context;
+
+	if (!eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, context))
+	{
+		ELYSIUM_ERROR("Failed to Make Surfaceless Context Current.");
+		Destroy();
+		return false;
+	}
+
+	if (!gladLoadGLLoader(reinterpret_cast<GLADloadproc>(eglGetProcAddress)))
+	{
+		ELYSIUM_ERROR("Failed to Load OpenGL Functions.");
+		Destroy();
+		return false;
+	}
+
+	ELYSIUM_INFO("Headless Context: EGL {0}.{1}, {2} ({3})", major, minor, 
+				 reinterpret_cast<const char*>(glGetString(GL_RENDERER)), reinterpret_cast<const char*>(glGetString(GL_VERSION)));
+
+	// Renderer globals are normally created by the application once its window context exists
+	Elysium::GlobalRendererBase::Init();
+	m_rendererInitialized = true;
+
+	return true;
+}
+
+void HeadlessContext::Destroy()
+{
+	if (m_rendererInitialized)
+	{
+		Elysium::GlobalRendererBase::Shutdown();
+		m_rendererInitialized = false;
+	}
+
+	if (m_display == nullptr)
+		return;
+
+	eglMakeCurrent(m_display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+	if (m_context != nullptr)
+		eglDestroyContext(m_display, m_context);
+	eglTerminate(m_display);
+
+	m_context = nullptr;
+	m_display = nullptr;
+}
\ No newline at end of file
@@ -0,0 +1,19 @@
+#pragma once
+
+// Window-less OpenGL context created through EGL, preferring Mesa's surfaceless
+// platform so rendering works on machines without a display or GPU.
+class HeadlessContext
+{
+public:
+	HeadlessContext();
+	~HeadlessContext();
+public:
+	bool Create();
+	void Destroy();
+
+	inline bool IsValid() const { return m_context != nullptr; }
+private:
+	void* m_display;
+	void* m_context;
+	bool m_rendererInitialized;
+};
\ No newline at end of file
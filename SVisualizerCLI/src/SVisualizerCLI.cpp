@@ -0,0 +1,259 @@
+#include "svis_pch.h"
+
+#include "Elysium.h"
+
+#include "Elysium/Utils/FileUtils.h"
+#include "Elysium/Renderer/RendererBase.h"
+
+#include "HeadlessContext.h"
+
+#include "ShaderPackage.h"
+#include "ShaderPackageSerializer.h"
+#include "ShaderPackageCompiler.h"
+#include "Rendering/PackageRenderer.h"
+#include "Rendering/ProgramBinaryCache.h"
+#include "Rendering/RenderTargetPool.h"
+#include "Textures/ImageDecoder.h"
+#include "Textures/SlotTexture.h"
+#include "Textures/VideoStream.h"
+
+#include <opencv2/opencv.hpp>
+
+#include <filesystem>
+
+struct RenderOptions
+{
+	std::vector<std::string> Packages;
+	std::string Output;
+	std::string Format = "png";
+	float Time = 0.0f;
+	int Width = 0;
+	int Height = 0;
+};
+
+static void PrintUsage()
+{
+	std::cout << "Usage: SVisualizerCLI <package.pshader> [<package.pshader>...] -o <output> [options]\n"
+			  << "\n"
+			  << "Renders shader packages without a window. With several packages the output is\n"
+			  << "treated as a directory and each image is named after its package.\n"
+			  << "\n"
+			  << "Options:\n"
+			  << "  -o, --output <path>    Output image, or directory when rendering several packages\n"
+			  << "  -t, --time <seconds>   Value of TIME for the rendered frame (default 0)\n"
+			  << "  -w, --width <pixels>   Overrides the package width\n"
+			  << "  -h, --height <pixels>  Overrides the package height\n"
+			  << "  -f, --format <ext>     Image format used for directory output (default png)\n"
+			  << "      --help             Shows this message\n";
+}
+
+static bool ParseArguments(int argc, char** argv, RenderOptions& options)
+{
+	for (int i = 1; i < argc; ++i)
+	{
+		const std::string arg = argv[i];
+		const bool hasValue = i + 1 < argc;
+
+		try
+		{
+			if ((arg == "-o" || arg == "--output") && hasValue)
+				options.Output = argv[++i];
+			else if ((arg == "-t" || arg == "--time") && hasValue)
+				options.Time = std::stof(argv[++i]);
+			else if ((arg == "-w" || arg == "--width") && hasValue)
+				options.Width = std::stoi(argv[++i]);
+			else if ((arg == "-h" || arg == "--height") && hasValue)
+				options.Height = std::stoi(argv[++i]);
+			else if ((arg == "-f" || arg == "--format") && hasValue)
+				options.Format = argv[++i];
+			else if (!arg.empty() && arg[0] != '-')
+				options.Packages.push_back(arg);
+			else
+				return false;
+		}
+		catch (const std::exception&)
+		{
+			std::cerr << "Invalid Value for " << arg << "\n";
+			return false;
+		}
+	}
+	return !options.Packages.empty() && !options.Output.empty();
+}
+
+static std::string GetOutputFilepath(const RenderOptions& options, const std::string& packageFilepath)
+{
+	if (options.Packages.size() == 1)
+		return options.Output;
+
+	std::filesystem::path output(options.Output);
+	output /= std::filesystem::path(packageFilepath).stem();
+	output += "." + options.Format;
+	return output.string();
+}
+
+static bool RenderPackage(const RenderOptions& options, const ShaderPackageCompiler& compiler, 
+						  const std::string& packageFilepath, const std::string& outputFilepath)
+{
+	if (!Elysium::FileUtils::FileExists(packageFilepath))
+	{
+		std::cerr << "Package Not Found: " << packageFilepath << "\n";
+		return false;
+	}
+
+	ShaderPackage package;
+	if (!ShaderPackageSerializer::Deserialize(package, packageFilepath))
+	{
+		std::cerr << "Invalid Package: " << packageFilepath << "\n";
+		return false;
+	}
+
+	if (options.Width > 0)
+		package.Dimensions.x = options.Width;
+	if (options.Height > 0)
+		package.Dimensions.y = options.Height;
+	package.Dimensions.x = std::min(std::max(package.Dimensions.x, 1), 4096);
+	package.Dimensions.y = std::min(std::max(package.Dimensions.y, 1), 4096);
+
+	std::string compileError;
+	if (!compiler.Compile(package, &compileError))
+	{
+		std::cerr << "Failed To Compile " << packageFilepath << ":\n" << compileError << "\n";
+		return false;
+	}
+
+	// Same uniform state the viewer uploads before drawing
+	Elysium::PostProcessData& postProcessRef = Elysium::CoreUniformBuffers::GetPostProcessDataRef();
+	postProcessRef.m_gammaAdjustment[0] = package.Gamma;
+	postProcessRef.m_exposure = package.Exposure;
+
+	Elysium::CameraData& cameraRef = Elysium::CoreUniformBuffers::GetCameraDataRef();
+	cameraRef.m_viewport = Elysium::Math::Vec4((float)package.Dimensions.x, (float)package.Dimensions.y, 0, 0);
+
+	Elysium::CoreUniformBuffers::UploadDirtyData();
+
+	// Bind the package images to the correct slots. Loaded with the editor's defaults so the package
+	// renders the same, including the compressed copy the editor cached next to the source.
+	const ImageLoadOptions defaultOptions;
+
+	std::array<Elysium::Shared<SlotTexture>, ShaderPackage::MaxTextureSlots> textures;
+	for (uint8_t i = 0; i < ShaderPackage::MaxTextureSlots; ++i)
+	{
+		const std::string& texturePath = package.Textures[i];
+		if (!texturePath.empty())
+		{
+			ImageData image;
+			bool fromCompressedCache = false;
+			// Streamed slots contribute the frame due at the render time
+			if (VideoStream::IsStreamPath(texturePath))
+			{
+				if (VideoStream::ReadFrame(texturePath, options.Time, image))
+					textures[i] = SlotTexture::Create(image, false);
+				else
+					std::cerr << "Unreadable Video in Slot " << static_cast<int>(i) << ": " << texturePath << "\n";
+			}
+			else if (!Elysium::FileUtils::FileExists(texturePath))
+				std::cerr << "Missing Texture in Slot " << static_cast<int>(i) << ": " << texturePath << "\n";
+			else
+			{
+				// Containers already hold the format their author picked
+				ImageLoadOptions loadOptions = defaultOptions;
+				if (ImageDecoder::IsContainer(texturePath))
+					loadOptions.Compress = false;
+
+				if (ImageDecoder::Load(texturePath, loadOptions, image, fromCompressedCache))
+					textures[i] = SlotTexture::Create(image, loadOptions.Compress);
+				else
+					std::cerr << "Unreadable Texture in Slot " << static_cast<int>(i) << ": " << texturePath << "\n";
+			}
+		}
+
+		if (textures[i] != nullptr)
+			textures[i]->Bind(ShaderPackage::FirstTextureUnit + i);
+		else
+			Elysium::GlobalRendererBase::GetDefaultTexture()->Bind(ShaderPackage::FirstTextureUnit + i);
+	}
+
+	PackageRenderer renderer;
+	renderer.SetBloom(package.BloomEnabled, package.BloomMode);
+	renderer.Resize(package.Dimensions.x, package.Dimensions.y);
+	renderer.SetBufferPasses(package.BufferShaders, package.Schedule);
+	renderer.SetPlaybackTime(options.Time);
+
+	const Elysium::Shared<Elysium::Shader>& shader = PackageRenderer::SelectShader(package.Shaders, package.BloomEnabled);
+	// A single frame, so feedback buffers only see their cleared history
+	renderer.DrawBufferPasses(shader);
+	renderer.Render(shader);
+
+	const uint32_t img_width = renderer.GetWidth();
+	const uint32_t img_height = renderer.GetHeight();
+
+	const Elysium::Shared<Elysium::FrameBuffer>& outputfbo = renderer.GetOutput();
+	outputfbo->Bind();
+	uint8_t* pixelData = outputfbo->ReadPixelBuffer(0, 0, 0, img_width, img_height);
+	outputfbo->Unbind();
+
+	cv::Mat currentImage(img_height, img_width, CV_8UC4);
+	std::memcpy(currentImage.data, pixelData, img_width * img_height * 4);
+	delete[] pixelData;
+
+	// Gl rows start at the bottom of the image
+	cv::Mat convertedImg;
+	cv::cvtColor(currentImage, convertedImg, cv::COLOR_RGBA2BGRA);
+	cv::flip(convertedImg, convertedImg, 0);
+
+	if (!cv::imwrite(outputFilepath, convertedImg))
+	{
+		std::cerr << "Failed To Write " << outputFilepath << "\n";
+		return false;
+	}
+
+	std::cout << packageFilepath << " -> " << outputFilepath << " (" << img_width << "x" << img_height << ", t=" << options.Time << ")\n";
+	return true;
+}
+
+int main(int argc, char** argv)
+{
+	RenderOptions options;
+	if (!ParseArguments(argc, argv, options))
+	{
+		PrintUsage();
+		return 1;
+	}
+
+	Elysium::Log::Init();
+
+	if (options.Packages.size() > 1)
+	{
+		std::error_code error;
+		std::filesystem::create_directories(options.Output, error);
+	}
+
+	HeadlessContext context;
+	if (!context.Create())
+		return 1;
+
+	// Batch runs over the same packages reuse the binaries of the previous run
+	ProgramBinaryCache::Init("Cache/Programs");
+
+	int failures = 0;
+	{
+		const ShaderPackageCompiler compiler;
+		if (!compiler.IsValid())
+			return 1;
+
+		for (const std::string& packageFilepath : options.Packages)
+		{
+			if (!RenderPackage(options, compiler, packageFilepath, GetOutputFilepath(options, packageFilepath)))
+				++failures;
+
+			// Packages of the same size render into the targets of the previous one
+			RenderTargetPool::EndFrame();
+		}
+	}
+
+	RenderTargetPool::Shutdown();
+	ProgramBinaryCache::Shutdown();
+	context.Destroy();
+
+	return failures == 0 ? 0 : 2;
+}
\ No newline at end of file
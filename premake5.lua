@@ -40,6 +40,11 @@ ElysiumProjDep()
 
 group ""
 	include "SVisualizer"
+
+	-- The headless renderer creates its context through EGL
+	if os.istarget("linux") then
+		include "SVisualizerCLI"
+	end
 group ""
 
 